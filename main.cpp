@@ -3,6 +3,1559 @@
 #include <iostream>
 #include "mystring_simd.h"
 #include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <streambuf>
+#include <vector>
+#include <functional>
+#include <charconv>
+
+//! копіювання блоками по 32 байти (2 x 16), далі по 16 і по 1 байту
+inline void neon_memcpy(const char* src, char* dst, size_t size) {
+    const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+    uint8_t* d = reinterpret_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        vst1q_u8(d + i, vld1q_u8(s + i));
+        vst1q_u8(d + i + 16, vld1q_u8(s + i + 16));
+    }
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(d + i, vld1q_u8(s + i));
+    }
+    for (; i < size; ++i) {
+        d[i] = s[i];
+    }
+}
+
+//! заповнення size байт літерою c
+inline void neon_memset(char* dst, char c, size_t size) {
+    uint8_t* d = reinterpret_cast<uint8_t*>(dst);
+    uint8x16_t fill = vdupq_n_u8(static_cast<uint8_t>(c));
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        vst1q_u8(d + i, fill);
+    }
+    for (; i < size; ++i) {
+        d[i] = static_cast<uint8_t>(c);
+    }
+}
+
+//! NEON не має movemask: звужуємо кожен байт результату порівняння до 4 біт
+//! (vshrn), тож байту i відповідають біти 4i..4i+3 64-бітної маски
+inline uint64_t neon_movemask(uint8x16_t cmp) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+//! позиція першої літери c у [src, src + size), або size, якщо її немає
+inline size_t neon_find_char(const char* src, size_t size, char c) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint8x16_t target = vdupq_n_u8(static_cast<uint8_t>(c));
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint64_t mask = neon_movemask(vceqq_u8(vld1q_u8(ptr + i), target));
+        if (mask != 0) {
+            return i + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+    for (; i < size; ++i) {
+        if (src[i] == c) {
+            return i;
+        }
+    }
+    return size;
+}
+
+//! позиція першого входження needle довжини len у [src + idx, src + size),
+//! або my_str_simd::not_found; кандидатів відсіює SIMD-порівняння першої
+//! та останньої літери needle, повністю порівнюються лише ті, де збіглися обидві
+inline size_t neon_find_str(const char* src, size_t size, const char* needle, size_t len, size_t idx) {
+    if (len == 0) {
+        return idx;
+    }
+    if (len > size - idx) {
+        return my_str_simd::not_found;
+    }
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(needle[0]));
+    uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(needle[len - 1]));
+    size_t i = idx;
+    for (; i + len - 1 + 16 <= size; i += 16) {
+        uint8x16_t cmp = vandq_u8(vceqq_u8(vld1q_u8(ptr + i), first),
+                                  vceqq_u8(vld1q_u8(ptr + i + len - 1), last));
+        uint64_t mask = neon_movemask(cmp) & 0x8888888888888888ull;
+        while (mask != 0) {
+            size_t const candidate = i + (__builtin_ctzll(mask) >> 2);
+            if (std::memcmp(src + candidate + 1, needle + 1, len - 1) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    for (; i + len <= size; ++i) {
+        if (src[i] == needle[0] && std::memcmp(src + i, needle, len) == 0) {
+            return i;
+        }
+    }
+    return my_str_simd::not_found;
+}
+
+//! позиція першого байта, в якому a і b різняться, або size
+inline size_t neon_mismatch(const char* a, const char* b, size_t size) {
+    const uint8_t* pa = reinterpret_cast<const uint8_t*>(a);
+    const uint8_t* pb = reinterpret_cast<const uint8_t*>(b);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint64_t mask = ~neon_movemask(vceqq_u8(vld1q_u8(pa + i), vld1q_u8(pb + i)));
+        if (mask != 0) {
+            return i + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+    for (; i < size; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+inline bool neon_equal(const char* a, const char* b, size_t size) {
+    return neon_mismatch(a, b, size) == size;
+}
+
+//! ASCII-пробіли як у std::isspace для "C" локалі: ' ', '\t', '\n', '\v', '\f', '\r'
+inline bool is_ascii_space(char c) {
+    return c == ' ' || static_cast<unsigned>(static_cast<unsigned char>(c) - '\t') <= 4u;
+}
+
+//! 0xFF у байтах-пробілах; '\t'..'\r' ідуть підряд, тож це одне
+//! беззнакове порівняння (c - '\t') <= 4
+inline uint8x16_t neon_space_bytes(uint8x16_t block) {
+    uint8x16_t is_blank = vceqq_u8(block, vdupq_n_u8(' '));
+    uint8x16_t is_ctrl = vcleq_u8(vsubq_u8(block, vdupq_n_u8('\t')), vdupq_n_u8(4));
+    return vorrq_u8(is_blank, is_ctrl);
+}
+
+//! позиція першої пробільної (want_space) чи непробільної літери, або size
+inline size_t neon_find_space(const char* src, size_t size, bool want_space = true) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint64_t const flip = want_space ? 0u : ~uint64_t(0);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint64_t mask = neon_movemask(neon_space_bytes(vld1q_u8(ptr + i))) ^ flip;
+        if (mask != 0) {
+            return i + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+    for (; i < size; ++i) {
+        if (is_ascii_space(src[i]) == want_space) {
+            return i;
+        }
+    }
+    return size;
+}
+
+//! кінець тексту без пробілів у хвості: позиція за останньою непробільною
+//! літерою, або 0. блоки йдуть від кінця, старші біти маски -- остання така літера
+inline size_t neon_rfind_nonspace(const char* src, size_t size) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    size_t i = size;
+    for (; i >= 16; i -= 16) {
+        uint64_t mask = ~neon_movemask(neon_space_bytes(vld1q_u8(ptr + i - 16)));
+        if (mask != 0) {
+            return i - (__builtin_clzll(mask) >> 2);
+        }
+    }
+    for (; i > 0; --i) {
+        if (!is_ascii_space(src[i - 1])) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+//! розмір блоку, яким my_str_simd_lines шукає кінці рядків
+constexpr size_t line_block = 16;
+
+//! маска '\n' у байтах [block, block + 16) тексту: по одному (старшому) біту
+//! з кожних 4 біт neon_movemask, тож байту i відповідає біт 4i + 3; хвіст
+//! коротший за блок перевіряється посимвольно
+inline uint64_t neon_newline_mask(const char* src, size_t size, size_t block) {
+    if (block + 16 <= size) {
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src + block);
+        uint8x16_t cmp = vceqq_u8(vld1q_u8(ptr), vdupq_n_u8('\n'));
+        return neon_movemask(cmp) & 0x8888888888888888ull;
+    }
+    uint64_t mask = 0;
+    for (size_t i = block; i < size; ++i) {
+        if (src[i] == '\n') {
+            mask |= uint64_t(8) << (4 * (i - block));
+        }
+    }
+    return mask;
+}
+
+//! найбільший charset, для якого split_any порівнює блок з кожною літерою
+//! окремо; для довших наборів маску блоку рахує таблиця посимвольно
+constexpr size_t split_set_limit = 16;
+
+//! ділить [src, src + size) на поля між роздільниками і дописує їх в out.
+//! block_mask(ptr) дає маску роздільників у 16 байтах від ptr у форматі
+//! neon_movemask, залишаючи лише біт 4i + 3 для байта i; is_delim перевіряє
+//! хвіст. маска обходиться побітово, тож на поле -- одна ctz-операція
+template <typename BlockMask, typename IsDelim>
+inline void neon_split(const char* src, size_t size, BlockMask block_mask, IsDelim is_delim,
+                       std::vector<my_str_simd_view>& out) {
+    out.clear();
+    size_t start = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint64_t mask = block_mask(src + i) & 0x8888888888888888ull;
+        while (mask != 0) {
+            size_t const pos = i + (__builtin_ctzll(mask) >> 2);
+            out.emplace_back(src + start, pos - start);
+            start = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    for (; i < size; ++i) {
+        if (is_delim(src[i])) {
+            out.emplace_back(src + start, i - start);
+            start = i + 1;
+        }
+    }
+    out.emplace_back(src + start, size - start);
+}
+
+//! копіює size байт з src у dst (можуть збігатися), міняючи регістр ASCII-літер
+//! з [first, last]: у них відрізняється лише біт 0x20. діапазон -- це одне
+//! беззнакове порівняння (c - first) <= (last - first)
+inline void neon_flip_case(const char* src, char* dst, size_t size, char first, char last) {
+    uint8x16_t const offset = vdupq_n_u8(static_cast<uint8_t>(first));
+    uint8x16_t const width = vdupq_n_u8(static_cast<uint8_t>(last - first));
+    uint8x16_t const bit = vdupq_n_u8(0x20);
+    const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t data = vld1q_u8(in + i);
+        uint8x16_t in_range = vcleq_u8(vsubq_u8(data, offset), width);
+        vst1q_u8(out + i, veorq_u8(data, vandq_u8(in_range, bit)));
+    }
+    for (; i < size; ++i) {
+        char const c = src[i];
+        dst[i] = (c >= first && c <= last) ? static_cast<char>(c ^ 0x20) : c;
+    }
+}
+
+//! найбільша кількість змінених байтів таблиці, для якої translate порівнює
+//! блок з кожним із них і підставляє заміну через vbsl; для більших таблиць
+//! перекодування йде повним пошуком у 256 записах
+constexpr size_t translate_blend_limit = 8;
+
+//! заміна кожного байта data на table[byte]. загальний шлях -- vqtbl4q по
+//! першій чверті таблиці й vqtbx4q по решті: індекси поза 0..63 лишають
+//! попередній результат, тож кожна чверть заповнює лише свої байти
+inline void neon_translate(char* data, size_t size, const uint8_t* table) {
+    uint8_t from[translate_blend_limit];
+    uint8_t to[translate_blend_limit];
+    size_t changed = 0;
+    for (size_t c = 0; c < 256 && changed <= translate_blend_limit; ++c) {
+        if (table[c] != c) {
+            if (changed < translate_blend_limit) {
+                from[changed] = static_cast<uint8_t>(c);
+                to[changed] = table[c];
+            }
+            ++changed;
+        }
+    }
+    if (changed == 0) {
+        return;
+    }
+    uint8_t* ptr = reinterpret_cast<uint8_t*>(data);
+    size_t i = 0;
+    if (changed <= translate_blend_limit) {
+        for (; i + 16 <= size; i += 16) {
+            uint8x16_t block = vld1q_u8(ptr + i);
+            uint8x16_t result = block;
+            for (size_t k = 0; k < changed; ++k) {
+                uint8x16_t hit = vceqq_u8(block, vdupq_n_u8(from[k]));
+                result = vbslq_u8(hit, vdupq_n_u8(to[k]), result);
+            }
+            vst1q_u8(ptr + i, result);
+        }
+    } else {
+        uint8x16x4_t quarters[4];
+        for (size_t q = 0; q < 4; ++q) {
+            for (size_t r = 0; r < 4; ++r) {
+                quarters[q].val[r] = vld1q_u8(table + 64 * q + 16 * r);
+            }
+        }
+        uint8x16_t const quarter = vdupq_n_u8(64);
+        for (; i + 16 <= size; i += 16) {
+            uint8x16_t index = vld1q_u8(ptr + i);
+            uint8x16_t result = vqtbl4q_u8(quarters[0], index);
+            for (size_t q = 1; q < 4; ++q) {
+                index = vsubq_u8(index, quarter);
+                result = vqtbx4q_u8(result, quarters[q], index);
+            }
+            vst1q_u8(ptr + i, result);
+        }
+    }
+    for (; i < size; ++i) {
+        ptr[i] = table[ptr[i]];
+    }
+}
+
+//! перевірка UTF-8 за алгоритмом Keiser-Lemire ("lookup"): кожна пара
+//! сусідніх байтів класифікується трьома таблицями по 16 записів -- за старшою
+//! і молодшою тетрадою попереднього байта та старшою тетрадою поточного.
+//! Біти записів -- види помилок; AND трьох результатів ненульовий лише для
+//! неправильних пар. Третій і четвертий байти послідовностей перевіряються
+//! окремо порівнянням з байтами за 2 і 3 позиції раніше
+constexpr uint8_t utf8_too_short = 1 << 0;
+constexpr uint8_t utf8_too_long = 1 << 1;
+constexpr uint8_t utf8_overlong_3 = 1 << 2;
+constexpr uint8_t utf8_too_large = 1 << 3;
+constexpr uint8_t utf8_surrogate = 1 << 4;
+constexpr uint8_t utf8_overlong_2 = 1 << 5;
+constexpr uint8_t utf8_too_large_1000 = 1 << 6;
+constexpr uint8_t utf8_overlong_4 = 1 << 6;
+constexpr uint8_t utf8_two_conts = 1 << 7;
+constexpr uint8_t utf8_carry = utf8_too_short | utf8_too_long | utf8_two_conts;
+
+alignas(16) constexpr uint8_t utf8_byte_1_high[16] = {
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    utf8_two_conts, utf8_two_conts, utf8_two_conts, utf8_two_conts,
+    utf8_too_short | utf8_overlong_2,
+    utf8_too_short,
+    utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+    utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4,
+};
+
+alignas(16) constexpr uint8_t utf8_byte_1_low[16] = {
+    utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4,
+    utf8_carry | utf8_overlong_2,
+    utf8_carry,
+    utf8_carry,
+    utf8_carry | utf8_too_large,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+};
+
+alignas(16) constexpr uint8_t utf8_byte_2_high[16] = {
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large_1000 | utf8_overlong_4,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+};
+
+//! найбільші байти, після яких блок може закінчитись: у трьох останніх
+//! позиціях не може стояти початок послідовності, довшої за решту блоку
+alignas(32) constexpr uint8_t utf8_incomplete_max[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+
+//! чи є [src, src + size) коректним UTF-8. по 64 байти за крок: якщо всі
+//! чотири блоки ASCII, перевіряється лише, що попередній блок не обірвав послідовність
+inline bool neon_is_valid_utf8(const char* src, size_t size) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint8x16_t const byte_1_high = vld1q_u8(utf8_byte_1_high);
+    uint8x16_t const byte_1_low = vld1q_u8(utf8_byte_1_low);
+    uint8x16_t const byte_2_high = vld1q_u8(utf8_byte_2_high);
+    uint8x16_t const incomplete_max = vld1q_u8(utf8_incomplete_max + 16);
+    uint8x16_t const low_bits = vdupq_n_u8(0x0F);
+    uint8x16_t prev = vdupq_n_u8(0);
+    uint8x16_t prev_incomplete = vdupq_n_u8(0);
+    uint8x16_t error = vdupq_n_u8(0);
+    auto check_block = [&](uint8x16_t block) {
+        uint8x16_t prev1 = vextq_u8(prev, block, 15);
+        uint8x16_t prev2 = vextq_u8(prev, block, 14);
+        uint8x16_t prev3 = vextq_u8(prev, block, 13);
+        uint8x16_t special = vandq_u8(
+            vandq_u8(vqtbl1q_u8(byte_1_high, vshrq_n_u8(prev1, 4)), vqtbl1q_u8(byte_1_low, vandq_u8(prev1, low_bits))),
+            vqtbl1q_u8(byte_2_high, vshrq_n_u8(block, 4)));
+        uint8x16_t must_continue = vorrq_u8(vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80)),
+                                            vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80)));
+        must_continue = vandq_u8(must_continue, vdupq_n_u8(0x80));
+        error = vorrq_u8(error, veorq_u8(must_continue, special));
+        prev_incomplete = vqsubq_u8(block, incomplete_max);
+        prev = block;
+    };
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        uint8x16x4_t blocks;
+        blocks.val[0] = vld1q_u8(ptr + i);
+        blocks.val[1] = vld1q_u8(ptr + i + 16);
+        blocks.val[2] = vld1q_u8(ptr + i + 32);
+        blocks.val[3] = vld1q_u8(ptr + i + 48);
+        uint8x16_t any = vorrq_u8(vorrq_u8(blocks.val[0], blocks.val[1]), vorrq_u8(blocks.val[2], blocks.val[3]));
+        if (vmaxvq_u8(any) < 0x80) {
+            error = vorrq_u8(error, prev_incomplete);
+            prev_incomplete = vdupq_n_u8(0);
+            prev = blocks.val[3];
+            continue;
+        }
+        for (size_t k = 0; k < 4; ++k) {
+            check_block(blocks.val[k]);
+        }
+    }
+    for (; i + 16 <= size; i += 16) {
+        check_block(vld1q_u8(ptr + i));
+    }
+    if (i < size) {
+        // хвіст доповнюється нулями (ASCII): обірвана послідовність дасть TOO_SHORT
+        uint8_t tail[16] = {};
+        std::memcpy(tail, ptr + i, size - i);
+        check_block(vld1q_u8(tail));
+    }
+    error = vorrq_u8(error, prev_incomplete);
+    return vmaxvq_u8(error) == 0;
+}
+
+//! маска байтів, що починають код UTF-8, тобто не є продовженнями 10xxxxxx
+//! (як знакові числа продовження лежать у [-128, -65]); по одному біту 4i + 3
+//! на байт i, тож popcount маски -- це кількість таких байтів
+inline uint64_t neon_lead_mask(const char* block) {
+    int8x16_t data = vreinterpretq_s8_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(block)));
+    return neon_movemask(vcgtq_s8(data, vdupq_n_s8(-65))) & 0x8888888888888888ull;
+}
+
+inline bool is_utf8_lead(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+}
+
+//! кількість кодів UTF-8 у [src, src + size): popcount маски початкових байтів
+inline size_t neon_utf8_length(const char* src, size_t size) {
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        count += __builtin_popcountll(neon_lead_mask(src + i));
+    }
+    for (; i < size; ++i) {
+        count += is_utf8_lead(src[i]);
+    }
+    return count;
+}
+
+//! зсув n-го (з нуля) коду в [src, src + size); size, якщо n -- кількість
+//! кодів, інакше my_str_simd::not_found. блоки без потрібного коду
+//! пропускаються за їх popcount, у знайденому блоці скидаються n молодших бітів
+inline size_t neon_utf8_offset(const char* src, size_t size, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint64_t mask = neon_lead_mask(src + i);
+        size_t const count = __builtin_popcountll(mask);
+        if (n < count) {
+            for (; n > 0; --n) {
+                mask &= mask - 1;
+            }
+            return i + (__builtin_ctzll(mask) >> 2);
+        }
+        n -= count;
+    }
+    for (; i < size; ++i) {
+        if (is_utf8_lead(src[i])) {
+            if (n == 0) {
+                return i;
+            }
+            --n;
+        }
+    }
+    return (n == 0) ? size : my_str_simd::not_found;
+}
+
+//! декодує один код UTF-8 з [src, src + size) у code_point і повертає його
+//! довжину в байтах, або 0 для неправильної послідовності: обірваної,
+//! надлишково закодованої, сурогату чи коду понад U+10FFFF
+inline size_t utf8_decode(const char* src, size_t size, char32_t& code_point) {
+    unsigned char const lead = static_cast<unsigned char>(src[0]);
+    if (lead < 0x80) {
+        code_point = lead;
+        return 1;
+    }
+    size_t length = 0;
+    char32_t smallest = 0;
+    if (lead >= 0xC2 && lead < 0xE0) {
+        length = 2;
+        code_point = lead & 0x1F;
+        smallest = 0x80;
+    } else if (lead >= 0xE0 && lead < 0xF0) {
+        length = 3;
+        code_point = lead & 0x0F;
+        smallest = 0x800;
+    } else if (lead >= 0xF0 && lead < 0xF5) {
+        length = 4;
+        code_point = lead & 0x07;
+        smallest = 0x10000;
+    } else {
+        return 0;
+    }
+    if (length > size) {
+        return 0;
+    }
+    for (size_t k = 1; k < length; ++k) {
+        unsigned char const next = static_cast<unsigned char>(src[k]);
+        if ((next & 0xC0) != 0x80) {
+            return 0;
+        }
+        code_point = (code_point << 6) | (next & 0x3F);
+    }
+    if (code_point < smallest || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+        return 0;
+    }
+    return length;
+}
+
+//! записує code_point в UTF-8 і повертає кількість байтів
+inline size_t utf8_encode(char32_t code_point, char* dst) {
+    if (code_point < 0x80) {
+        dst[0] = static_cast<char>(code_point);
+        return 1;
+    }
+    if (code_point < 0x800) {
+        dst[0] = static_cast<char>(0xC0 | (code_point >> 6));
+        dst[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+    if (code_point < 0x10000) {
+        dst[0] = static_cast<char>(0xE0 | (code_point >> 12));
+        dst[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        dst[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    dst[0] = static_cast<char>(0xF0 | (code_point >> 18));
+    dst[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    dst[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    dst[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+//! записує code_point в UTF-16 (сурогатною парою понад U+FFFF) і
+//! повертає кількість одиниць
+inline size_t utf16_encode(char32_t code_point, char16_t* dst) {
+    if (code_point < 0x10000) {
+        dst[0] = static_cast<char16_t>(code_point);
+        return 1;
+    }
+    code_point -= 0x10000;
+    dst[0] = static_cast<char16_t>(0xD800 | (code_point >> 10));
+    dst[1] = static_cast<char16_t>(0xDC00 | (code_point & 0x3FF));
+    return 2;
+}
+
+//! декодує один код UTF-16 з [src, src + size) і повертає кількість
+//! одиниць, або 0 для непарного сурогату
+inline size_t utf16_decode(const char16_t* src, size_t size, char32_t& code_point) {
+    char16_t const unit = src[0];
+    if (unit < 0xD800 || unit > 0xDFFF) {
+        code_point = unit;
+        return 1;
+    }
+    if (unit > 0xDBFF || size < 2 || src[1] < 0xDC00 || src[1] > 0xDFFF) {
+        return 0;
+    }
+    code_point = 0x10000 + ((char32_t(unit) - 0xD800) << 10) + (char32_t(src[1]) - 0xDC00);
+    return 2;
+}
+
+//! скалярний крок перекодування UTF-8 -> UTF-16/32 для одного коду;
+//! повертає кількість прочитаних байтів (0 -- неправильна послідовність)
+template <typename Unit>
+inline size_t utf8_transcode_one(const char* src, size_t size, Unit* dst, size_t& written) {
+    char32_t code_point = 0;
+    size_t const length = utf8_decode(src, size, code_point);
+    if (length == 0) {
+        return 0;
+    }
+    if constexpr (sizeof(Unit) == 2) {
+        written += utf16_encode(code_point, dst + written);
+    } else {
+        dst[written++] = code_point;
+    }
+    return length;
+}
+
+//! UTF-8 -> UTF-16 в out. повертає my_str_simd::not_found, або зсув першої
+//! неправильної послідовності (тоді out -- перекодований до неї префікс).
+//! ASCII-префікс кожного 16-байтового блоку розширюється нулями одразу
+//! (vmovl_u8), решта -- скалярно по одному коду. одиниць UTF-16 не більше,
+//! ніж байтів UTF-8, тож out виділяється один раз
+inline size_t neon_utf8_to_utf16(const char* src, size_t size, std::u16string& out) {
+    out.resize(size);
+    char16_t* dst = &out[0];
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    size_t i = 0;
+    size_t written = 0;
+    while (i < size) {
+        if (i + 16 <= size) {
+            uint8x16_t block = vld1q_u8(ptr + i);
+            uint64_t const non_ascii = neon_movemask(vcgeq_u8(block, vdupq_n_u8(0x80)));
+            uint16_t* out_units = reinterpret_cast<uint16_t*>(dst + written);
+            vst1q_u16(out_units, vmovl_u8(vget_low_u8(block)));
+            vst1q_u16(out_units + 8, vmovl_u8(vget_high_u8(block)));
+            size_t const ascii = (non_ascii == 0) ? 16 : (__builtin_ctzll(non_ascii) >> 2);
+            i += ascii;
+            written += ascii;
+            if (non_ascii == 0) {
+                continue;
+            }
+        }
+        size_t const length = utf8_transcode_one(src + i, size - i, dst, written);
+        if (length == 0) {
+            out.resize(written);
+            return i;
+        }
+        i += length;
+    }
+    out.resize(written);
+    return my_str_simd::not_found;
+}
+
+//! UTF-8 -> UTF-32, як neon_utf8_to_utf16; ASCII розширюється двома vmovl
+inline size_t neon_utf8_to_utf32(const char* src, size_t size, std::u32string& out) {
+    out.resize(size);
+    char32_t* dst = &out[0];
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    size_t i = 0;
+    size_t written = 0;
+    while (i < size) {
+        if (i + 16 <= size) {
+            uint8x16_t block = vld1q_u8(ptr + i);
+            uint64_t const non_ascii = neon_movemask(vcgeq_u8(block, vdupq_n_u8(0x80)));
+            uint16x8_t low = vmovl_u8(vget_low_u8(block));
+            uint16x8_t high = vmovl_u8(vget_high_u8(block));
+            uint32_t* out_units = reinterpret_cast<uint32_t*>(dst + written);
+            vst1q_u32(out_units, vmovl_u16(vget_low_u16(low)));
+            vst1q_u32(out_units + 4, vmovl_u16(vget_high_u16(low)));
+            vst1q_u32(out_units + 8, vmovl_u16(vget_low_u16(high)));
+            vst1q_u32(out_units + 12, vmovl_u16(vget_high_u16(high)));
+            size_t const ascii = (non_ascii == 0) ? 16 : (__builtin_ctzll(non_ascii) >> 2);
+            i += ascii;
+            written += ascii;
+            if (non_ascii == 0) {
+                continue;
+            }
+        }
+        size_t const length = utf8_transcode_one(src + i, size - i, dst, written);
+        if (length == 0) {
+            out.resize(written);
+            return i;
+        }
+        i += length;
+    }
+    out.resize(written);
+    return my_str_simd::not_found;
+}
+
+//! UTF-16 -> UTF-8 у dst (місця -- щонайменше 3 байти на одиницю). повертає
+//! my_str_simd::not_found, або індекс непарного сурогату. ASCII-префікс
+//! 16 одиниць звужується vmovn_u16; маска не-ASCII одиниць -- теж звужена
+//! до байта на одиницю
+inline size_t neon_utf16_to_utf8(const char16_t* src, size_t size, char* dst, size_t& written) {
+    const uint16_t* ptr = reinterpret_cast<const uint16_t*>(src);
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    uint16x8_t const limit = vdupq_n_u16(0x80);
+    written = 0;
+    size_t i = 0;
+    while (i < size) {
+        if (i + 16 <= size) {
+            uint16x8_t low = vld1q_u16(ptr + i);
+            uint16x8_t high = vld1q_u16(ptr + i + 8);
+            uint8x16_t wide = vcombine_u8(vmovn_u16(vcgeq_u16(low, limit)), vmovn_u16(vcgeq_u16(high, limit)));
+            uint64_t const non_ascii = neon_movemask(wide);
+            vst1q_u8(out + written, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+            size_t const ascii = (non_ascii == 0) ? 16 : (__builtin_ctzll(non_ascii) >> 2);
+            i += ascii;
+            written += ascii;
+            if (non_ascii == 0) {
+                continue;
+            }
+        }
+        char32_t code_point = 0;
+        size_t const length = utf16_decode(src + i, size - i, code_point);
+        if (length == 0) {
+            return i;
+        }
+        written += utf8_encode(code_point, dst + written);
+        i += length;
+    }
+    return my_str_simd::not_found;
+}
+
+//! UTF-32 -> UTF-8 у dst (місця -- щонайменше 4 байти на одиницю). повертає
+//! my_str_simd::not_found, або індекс коду понад U+10FFFF чи сурогату.
+//! ASCII-префікс 16 одиниць звужується двома vmovn
+inline size_t neon_utf32_to_utf8(const char32_t* src, size_t size, char* dst, size_t& written) {
+    const uint32_t* ptr = reinterpret_cast<const uint32_t*>(src);
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    uint32x4_t const limit = vdupq_n_u32(0x80);
+    written = 0;
+    size_t i = 0;
+    while (i < size) {
+        if (i + 16 <= size) {
+            uint32x4_t units[4];
+            uint16x8_t flags[2];
+            uint16x8_t words[2];
+            for (size_t k = 0; k < 4; ++k) {
+                units[k] = vld1q_u32(ptr + i + 4 * k);
+            }
+            for (size_t k = 0; k < 2; ++k) {
+                flags[k] = vcombine_u16(vmovn_u32(vcgeq_u32(units[2 * k], limit)), vmovn_u32(vcgeq_u32(units[2 * k + 1], limit)));
+                words[k] = vcombine_u16(vmovn_u32(units[2 * k]), vmovn_u32(units[2 * k + 1]));
+            }
+            uint64_t const non_ascii = neon_movemask(vcombine_u8(vmovn_u16(flags[0]), vmovn_u16(flags[1])));
+            vst1q_u8(out + written, vcombine_u8(vmovn_u16(words[0]), vmovn_u16(words[1])));
+            size_t const ascii = (non_ascii == 0) ? 16 : (__builtin_ctzll(non_ascii) >> 2);
+            i += ascii;
+            written += ascii;
+            if (non_ascii == 0) {
+                continue;
+            }
+        }
+        char32_t const code_point = src[i];
+        if (code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+            return i;
+        }
+        written += utf8_encode(code_point, dst + written);
+        ++i;
+    }
+    return my_str_simd::not_found;
+}
+
+//! алфавіт base64 (RFC 4648) і зворотна таблиця для ASCII: значення
+//! літери, або 0xFF для літер поза алфавітом
+constexpr char base64_alphabet[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct base64_table {
+    uint8_t values[128];
+
+    constexpr base64_table() : values() {
+        for (size_t k = 0; k < 128; ++k) {
+            values[k] = 0xFF;
+        }
+        for (size_t k = 0; k < 64; ++k) {
+            values[static_cast<unsigned char>(base64_alphabet[k])] = static_cast<uint8_t>(k);
+        }
+    }
+};
+
+alignas(16) constexpr base64_table base64_values{};
+
+inline uint8_t base64_value(char c) {
+    unsigned char const byte = static_cast<unsigned char>(c);
+    return byte < 128 ? base64_values.values[byte] : 0xFF;
+}
+
+//! скалярний base64 для хвоста: повні трійки, тоді остача з '='
+inline void base64_encode_scalar(const char* src, size_t size, char* dst) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t const triple = (uint32_t(in[i]) << 16) | (uint32_t(in[i + 1]) << 8) | in[i + 2];
+        *dst++ = base64_alphabet[triple >> 18];
+        *dst++ = base64_alphabet[(triple >> 12) & 0x3F];
+        *dst++ = base64_alphabet[(triple >> 6) & 0x3F];
+        *dst++ = base64_alphabet[triple & 0x3F];
+    }
+    if (i < size) {
+        uint32_t triple = uint32_t(in[i]) << 16;
+        if (i + 1 < size) {
+            triple |= uint32_t(in[i + 1]) << 8;
+        }
+        *dst++ = base64_alphabet[triple >> 18];
+        *dst++ = base64_alphabet[(triple >> 12) & 0x3F];
+        *dst++ = (i + 1 < size) ? base64_alphabet[(triple >> 6) & 0x3F] : '=';
+        *dst++ = '=';
+    }
+}
+
+//! скалярне декодування base64 без '=': повні четвірки, тоді остача з 2 чи 3
+//! літер. Дописує байти в dst + written; повертає позицію першої літери поза
+//! алфавітом, або size
+inline size_t base64_decode_scalar(const char* src, size_t size, char* dst, size_t& written) {
+    size_t i = 0;
+    while (i < size) {
+        size_t const group = (size - i < 4) ? size - i : 4;
+        uint32_t quad = 0;
+        for (size_t k = 0; k < group; ++k) {
+            uint8_t const value = base64_value(src[i + k]);
+            if (value == 0xFF) {
+                return i + k;
+            }
+            quad |= uint32_t(value) << (18 - 6 * k);
+        }
+        if (group == 1) {
+            return i;
+        }
+        for (size_t k = 0; k + 1 < group; ++k) {
+            dst[written++] = static_cast<char>(quad >> (16 - 8 * k));
+        }
+        i += group;
+    }
+    return size;
+}
+
+//! base64 з [src, src + size) у dst ((size + 2) / 3 * 4 літер). за крок -- 48
+//! байтів: vld3q розкладає трійки по регістрах, зсуви вирізають чотири
+//! 6-бітні індекси, а vqtbl4q перетворює їх на літери цілим алфавітом
+inline void neon_base64_encode(const char* src, size_t size, char* dst) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    uint8x16x4_t alphabet;
+    for (size_t r = 0; r < 4; ++r) {
+        alphabet.val[r] = vld1q_u8(reinterpret_cast<const uint8_t*>(base64_alphabet) + 16 * r);
+    }
+    uint8x16_t const low_6 = vdupq_n_u8(0x3F);
+    size_t i = 0;
+    for (; i + 48 <= size; i += 48) {
+        uint8x16x3_t in = vld3q_u8(ptr + i);
+        uint8x16x4_t chars;
+        chars.val[0] = vshrq_n_u8(in.val[0], 2);
+        chars.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), low_6);
+        chars.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), low_6);
+        chars.val[3] = vandq_u8(in.val[2], low_6);
+        for (size_t k = 0; k < 4; ++k) {
+            chars.val[k] = vqtbl4q_u8(alphabet, chars.val[k]);
+        }
+        vst4q_u8(out, chars);
+        out += 64;
+    }
+    base64_encode_scalar(src + i, size - i, reinterpret_cast<char*>(out));
+}
+
+//! декодує base64 без '=' (size % 4 != 1) у dst + written. повертає
+//! my_str_simd::not_found, або позицію першої літери поза алфавітом. vld4q
+//! розкладає четвірки по регістрах, значення дає зворотна таблиця на 128
+//! записів (vqtbl4q + vqtbx4q); блок з помилкою доходить скалярний цикл
+inline size_t neon_base64_decode(const char* src, size_t size, char* dst, size_t& written) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint8x16x4_t lower_half;
+    uint8x16x4_t upper_half;
+    for (size_t r = 0; r < 4; ++r) {
+        lower_half.val[r] = vld1q_u8(base64_values.values + 16 * r);
+        upper_half.val[r] = vld1q_u8(base64_values.values + 64 + 16 * r);
+    }
+    uint8x16_t const half = vdupq_n_u8(64);
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        uint8x16x4_t in = vld4q_u8(ptr + i);
+        uint8x16_t invalid = vdupq_n_u8(0);
+        for (size_t k = 0; k < 4; ++k) {
+            uint8x16_t value = vqtbl4q_u8(lower_half, in.val[k]);
+            value = vqtbx4q_u8(value, upper_half, vsubq_u8(in.val[k], half));
+            invalid = vorrq_u8(invalid, vorrq_u8(value, in.val[k]));
+            in.val[k] = value;
+        }
+        if (vmaxvq_u8(invalid) >= 0x80) {
+            break;
+        }
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+        vst3q_u8(reinterpret_cast<uint8_t*>(dst + written), bytes);
+        written += 48;
+    }
+    size_t const bad = base64_decode_scalar(src + i, size - i, dst, written);
+    return bad == size - i ? my_str_simd::not_found : i + bad;
+}
+
+constexpr char hex_digits[17] = "0123456789abcdef";
+
+//! значення шістнадцяткової цифри (будь-якого регістру), або 0xFF
+inline uint8_t hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    }
+    char const lower = static_cast<char>(c | 0x20);
+    if (lower >= 'a' && lower <= 'f') {
+        return static_cast<uint8_t>(lower - 'a' + 10);
+    }
+    return 0xFF;
+}
+
+inline void hex_encode_scalar(const char* src, size_t size, char* dst) {
+    for (size_t i = 0; i < size; ++i) {
+        unsigned char const byte = static_cast<unsigned char>(src[i]);
+        *dst++ = hex_digits[byte >> 4];
+        *dst++ = hex_digits[byte & 0x0F];
+    }
+}
+
+//! пари цифр з [src, src + size) (size парне) у байти dst; повертає позицію
+//! першої нецифри, або size
+inline size_t hex_decode_scalar(const char* src, size_t size, char* dst) {
+    for (size_t i = 0; i < size; i += 2) {
+        uint8_t const high = hex_value(src[i]);
+        if (high == 0xFF) {
+            return i;
+        }
+        uint8_t const low = hex_value(src[i + 1]);
+        if (low == 0xFF) {
+            return i + 1;
+        }
+        *dst++ = static_cast<char>((high << 4) | low);
+    }
+    return size;
+}
+
+//! байти [src, src + size) як 2 * size шістнадцяткових цифр у dst. за крок --
+//! 16 байтів: півбайти стають цифрами через vqtbl1q, а vst2q чергує старші
+//! й молодші
+inline void neon_hex_encode(const char* src, size_t size, char* dst) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    uint8x16_t const digits = vld1q_u8(reinterpret_cast<const uint8_t*>(hex_digits));
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t in = vld1q_u8(ptr + i);
+        uint8x16x2_t chars;
+        chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(in, 4));
+        chars.val[1] = vqtbl1q_u8(digits, vandq_u8(in, vdupq_n_u8(0x0F)));
+        vst2q_u8(out + 2 * i, chars);
+    }
+    hex_encode_scalar(src + i, size - i, dst + 2 * i);
+}
+
+//! значення 16 цифр і ознака нецифр: '0'..'9' та ('a'..'f' | 0x20) -- два
+//! беззнакові порівняння діапазонів
+inline uint8x16_t neon_hex_values(uint8x16_t chars, uint8x16_t& invalid) {
+    uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+    uint8x16_t letter = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t is_digit = vcleq_u8(digit, vdupq_n_u8(9));
+    uint8x16_t is_letter = vcleq_u8(letter, vdupq_n_u8(5));
+    invalid = vorrq_u8(invalid, vmvnq_u8(vorrq_u8(is_digit, is_letter)));
+    return vbslq_u8(is_digit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+}
+
+//! пари цифр з [src, src + size) (size парне) у байти dst. повертає
+//! my_str_simd::not_found, або позицію першої нецифри. vld2q розводить
+//! старші й молодші цифри по регістрах, тож байт -- один зсув і or
+inline size_t neon_hex_decode(const char* src, size_t size, char* dst) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        uint8x16x2_t chars = vld2q_u8(ptr + i);
+        uint8x16_t invalid = vdupq_n_u8(0);
+        uint8x16_t high = neon_hex_values(chars.val[0], invalid);
+        uint8x16_t low = neon_hex_values(chars.val[1], invalid);
+        if (vmaxvq_u8(invalid) != 0) {
+            break;
+        }
+        vst1q_u8(out + i / 2, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+    size_t const bad = hex_decode_scalar(src + i, size - i, dst + i / 2);
+    return bad == size - i ? my_str_simd::not_found : i + bad;
+}
+
+//! літери, які треба екранувати в рядку JSON, у тексті HTML та які
+//! вимагають лапок у полі CSV
+inline bool is_json_special(char c) {
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+inline bool is_html_special(char c) {
+    return c == '&' || c == '<' || c == '>' || c == '"' || c == '\'';
+}
+
+inline bool is_csv_special(char c) {
+    return c == ',' || c == '"' || c == '\n' || c == '\r';
+}
+
+template <typename Str>
+inline void json_escape_char(Str& out, char c) {
+    switch (c) {
+        case '"': out.append("\\\"", 2); break;
+        case '\\': out.append("\\\\", 2); break;
+        case '\n': out.append("\\n", 2); break;
+        case '\r': out.append("\\r", 2); break;
+        case '\t': out.append("\\t", 2); break;
+        case '\b': out.append("\\b", 2); break;
+        case '\f': out.append("\\f", 2); break;
+        default: {
+            unsigned char const byte = static_cast<unsigned char>(c);
+            char const code[6] = {'\\', 'u', '0', '0', hex_digits[byte >> 4], hex_digits[byte & 0x0F]};
+            out.append(code, 6);
+        }
+    }
+}
+
+template <typename Str>
+inline void html_escape_char(Str& out, char c) {
+    switch (c) {
+        case '&': out.append("&amp;", 5); break;
+        case '<': out.append("&lt;", 4); break;
+        case '>': out.append("&gt;", 4); break;
+        case '"': out.append("&quot;", 6); break;
+        default: out.append("&#39;", 5); break;
+    }
+}
+
+//! маски особливих літер JSON, HTML і CSV у 16 байтах від block у форматі
+//! neon_movemask. керівні байти JSON (< 0x20) -- одне vcltq
+inline uint64_t neon_json_special_mask(const char* block) {
+    uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+    uint8x16_t hits = vorrq_u8(vceqq_u8(data, vdupq_n_u8('"')), vceqq_u8(data, vdupq_n_u8('\\')));
+    hits = vorrq_u8(hits, vcltq_u8(data, vdupq_n_u8(0x20)));
+    return neon_movemask(hits);
+}
+
+inline uint64_t neon_html_special_mask(const char* block) {
+    uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+    uint8x16_t hits = vorrq_u8(vceqq_u8(data, vdupq_n_u8('&')), vceqq_u8(data, vdupq_n_u8('<')));
+    hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8('>')));
+    hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8('"')));
+    hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8('\'')));
+    return neon_movemask(hits);
+}
+
+inline uint64_t neon_csv_special_mask(const char* block) {
+    uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+    uint8x16_t hits = vorrq_u8(vceqq_u8(data, vdupq_n_u8(',')), vceqq_u8(data, vdupq_n_u8('"')));
+    hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8('\n')));
+    hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8('\r')));
+    return neon_movemask(hits);
+}
+
+inline uint64_t neon_quote_mask(const char* block) {
+    uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+    return neon_movemask(vceqq_u8(data, vdupq_n_u8('"')));
+}
+
+//! позиція першої особливої літери, або size: block_mask(ptr) -- маска
+//! особливих літер у 16 байтах від ptr, is_special перевіряє хвіст
+template <typename BlockMask, typename IsSpecial>
+inline size_t neon_find_special(const char* src, size_t size, BlockMask block_mask, IsSpecial is_special) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint64_t const mask = block_mask(src + i);
+        if (mask != 0) {
+            return i + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+    for (; i < size; ++i) {
+        if (is_special(src[i])) {
+            return i;
+        }
+    }
+    return size;
+}
+
+//! дописує [src, src + size) в out, підставляючи escape(out, c) замість кожної
+//! особливої літери. чистий блок коштує одну перевірку маски, а ділянки між
+//! особливими літерами копіюються одним векторним append
+template <typename BlockMask, typename IsSpecial, typename Escape>
+inline void neon_escape(const char* src, size_t size, BlockMask block_mask, IsSpecial is_special, Escape escape,
+                        my_str_simd& out) {
+    size_t start = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint64_t mask = block_mask(src + i) & 0x8888888888888888ull;
+        while (mask != 0) {
+            size_t const pos = i + (__builtin_ctzll(mask) >> 2);
+            out.append(src + start, pos - start);
+            escape(out, src[pos]);
+            start = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    for (; i < size; ++i) {
+        if (is_special(src[i])) {
+            out.append(src + start, i - start);
+            escape(out, src[i]);
+            start = i + 1;
+        }
+    }
+    out.append(src + start, size - start);
+}
+
+//! маска байтів блоку з набору set (літерал, на кшталт "?#") у форматі
+//! neon_movemask: по одному порівнянню на літеру набору
+template <size_t N>
+inline uint64_t neon_any_of_mask(const char* block, const char (&set)[N]) {
+    uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+    uint8x16_t hits = vdupq_n_u8(0);
+    for (size_t k = 0; k + 1 < N; ++k) {
+        hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8(static_cast<uint8_t>(set[k]))));
+    }
+    return neon_movemask(hits);
+}
+
+//! позиція першої літери з набору set у [src, src + size), або size
+template <size_t N>
+inline size_t neon_find_any_of(const char* src, size_t size, const char (&set)[N]) {
+    return neon_find_special(src, size,
+        [&set](const char* block) { return neon_any_of_mask(block, set); },
+        [&set](char c) { return std::char_traits<char>::find(set, N - 1, c) != nullptr; });
+}
+
+//! пари цифр "00".."99": число форматується по дві цифри за ділення
+constexpr char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+//! записує десятковий запис value, що закінчується перед end, і повертає
+//! кількість цифр (не більше 20)
+inline size_t format_uint(uint64_t value, char* end) {
+    char* pos = end;
+    while (value >= 100) {
+        size_t const pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--pos = digit_pairs[pair + 1];
+        *--pos = digit_pairs[pair];
+    }
+    if (value >= 10) {
+        *--pos = digit_pairs[value * 2 + 1];
+        *--pos = digit_pairs[value * 2];
+    } else {
+        *--pos = static_cast<char>('0' + value);
+    }
+    return static_cast<size_t>(end - pos);
+}
+
+//! значення не більше ніж 16 цифр [src, src + size), або false для нецифри.
+//! цифри вирівнюються праворуч у блоці з '0', перевіряються одним vmaxvq, а
+//! зводяться множенням-додаванням сусідніх половин ширших лінійок: пари в
+//! u16, четвірки в u32, вісімки -- у двох u64
+inline bool neon_parse_digits16(const char* src, size_t size, uint64_t& value) {
+    alignas(16) uint8_t block[16];
+    std::memset(block, '0', 16);
+    std::memcpy(block + 16 - size, src, size);
+    uint8x16_t digits = vsubq_u8(vld1q_u8(block), vdupq_n_u8('0'));
+    if (vmaxvq_u8(digits) > 9) {
+        return false;
+    }
+    uint16x8_t pairs = vreinterpretq_u16_u8(digits);
+    pairs = vmlaq_n_u16(vshrq_n_u16(pairs, 8), vandq_u16(pairs, vdupq_n_u16(0xFF)), 10);
+    uint32x4_t quads = vreinterpretq_u32_u16(pairs);
+    quads = vmlaq_n_u32(vshrq_n_u32(quads, 16), vandq_u32(quads, vdupq_n_u32(0xFFFF)), 100);
+    uint64x2_t const octets = vreinterpretq_u64_u32(quads);
+    uint64_t const high = vgetq_lane_u64(octets, 0);
+    uint64_t const low = vgetq_lane_u64(octets, 1);
+    value = ((high & 0xFFFFFFFF) * 10000 + (high >> 32)) * 100000000 + (low & 0xFFFFFFFF) * 10000 + (low >> 32);
+    return true;
+}
+
+//! значення цифр [src, src + size) (непорожньо): 16 цифр за крок, старший
+//! шматок -- остача. Повертає false, якщо трапилась нецифра; overflow -- якщо
+//! значення не вміщується в uint64_t (цифри при цьому перевіряються до кінця)
+inline bool neon_parse_uint(const char* src, size_t size, uint64_t& value, bool& overflow) {
+    overflow = false;
+    value = 0;
+    size_t pos = 0;
+    size_t length = (size % 16 == 0) ? 16 : size % 16;
+    while (pos < size) {
+        uint64_t chunk = 0;
+        if (!neon_parse_digits16(src + pos, length, chunk)) {
+            return false;
+        }
+        if (pos != 0 && (__builtin_mul_overflow(value, 10000000000000000ull, &value) || __builtin_add_overflow(value, chunk, &value))) {
+            overflow = true;
+        } else if (pos == 0) {
+            value = chunk;
+        }
+        pos += length;
+        length = 16;
+    }
+    return true;
+}
+
+//! швидкий шлях to_double (Clinger): [+-]цифри[.цифри][e[+-]цифри] з не
+//! більше ніж 19 значущими цифрами, мантисою до 2^53 і десятковим порядком у
+//! [-22, 22]. Тоді і мантиса, і 10^порядок точні в double, тож одне множення чи
+//! ділення дає правильно заокруглений результат. Цифри зводить parse_uint
+//! (векторно); false -- вхід поза цим шляхом, і його розбирає std::from_chars
+template <typename ParseUint>
+inline bool parse_double_fast(const char* src, size_t size, ParseUint parse_uint, double& value) {
+    static constexpr double exact_powers[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    size_t pos = 0;
+    bool const negative = size > 0 && src[0] == '-';
+    if (size > 0 && (src[0] == '-' || src[0] == '+')) {
+        ++pos;
+    }
+    size_t const int_begin = pos;
+    while (pos < size && is_digit(src[pos])) {
+        ++pos;
+    }
+    size_t const int_length = pos - int_begin;
+    size_t frac_begin = pos;
+    if (pos < size && src[pos] == '.') {
+        frac_begin = ++pos;
+        while (pos < size && is_digit(src[pos])) {
+            ++pos;
+        }
+    }
+    size_t const frac_length = pos - frac_begin;
+    if (int_length + frac_length == 0 || int_length + frac_length > 19) {
+        return false;
+    }
+    int64_t exponent = 0;
+    if (pos < size && (src[pos] == 'e' || src[pos] == 'E')) {
+        ++pos;
+        bool const exponent_negative = pos < size && src[pos] == '-';
+        if (pos < size && (src[pos] == '-' || src[pos] == '+')) {
+            ++pos;
+        }
+        size_t const exponent_begin = pos;
+        while (pos < size && is_digit(src[pos]) && pos - exponent_begin < 4) {
+            exponent = exponent * 10 + (src[pos] - '0');
+            ++pos;
+        }
+        if (pos == exponent_begin) {
+            return false;
+        }
+        exponent = exponent_negative ? -exponent : exponent;
+    }
+    if (pos != size) {
+        return false;
+    }
+    uint64_t mantissa = 0;
+    uint64_t fraction = 0;
+    bool overflow = false;
+    if (int_length != 0) {
+        parse_uint(src + int_begin, int_length, mantissa, overflow);
+    }
+    if (frac_length != 0) {
+        parse_uint(src + frac_begin, frac_length, fraction, overflow);
+        for (size_t k = 0; k < frac_length; ++k) {
+            mantissa *= 10;
+        }
+        mantissa += fraction;
+        exponent -= static_cast<int64_t>(frac_length);
+    }
+    if (mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+        return false;
+    }
+    double result = static_cast<double>(mantissa);
+    result = exponent < 0 ? result / exact_powers[-exponent] : result * exact_powers[exponent];
+    value = negative ? -result : result;
+    return true;
+}
+
+//! маска екранованих літер 64-байтового блоку JSON за маскою '\\' (як у
+//! simdjson): серія '\\' непарної довжини екранує наступну літеру. Серії, що
+//! починаються на непарних позиціях, виділяє додавання з переносом; prev_escaped
+//! переносить екранування через межу блоків
+inline uint64_t json_escaped_mask(uint64_t backslash, uint64_t& prev_escaped) {
+    backslash &= ~prev_escaped;
+    uint64_t const follows_escape = (backslash << 1) | prev_escaped;
+    uint64_t const even_bits = 0x5555555555555555ull;
+    uint64_t const odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+    uint64_t sequences_starting_on_even_bits = 0;
+    prev_escaped = __builtin_add_overflow(odd_sequence_starts, backslash, &sequences_starting_on_even_bits) ? 1 : 0;
+    uint64_t const invert_mask = sequences_starting_on_even_bits << 1;
+    return (even_bits ^ invert_mask) & follows_escape;
+}
+
+//! префіксний XOR маски: біт i -- парність бітів 0..i. Шість зсувів
+//! з подвоєнням замість безпереносного множення, якого немає в базовому наборі
+inline uint64_t prefix_xor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+//! повна 64-бітна маска (біт на байт) з чотирьох 16-байтових результатів
+//! порівняння: байти лишають свій біт позиції, а три vpaddq складають їх
+inline uint64_t neon_bitmask64(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) {
+    static constexpr uint8_t positions[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t const bits = vld1q_u8(positions);
+    uint8x16_t low = vpaddq_u8(vandq_u8(m0, bits), vandq_u8(m1, bits));
+    uint8x16_t high = vpaddq_u8(vandq_u8(m2, bits), vandq_u8(m3, bits));
+    low = vpaddq_u8(low, high);
+    low = vpaddq_u8(low, low);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(low), 0);
+}
+
+//! маски лапок, '\' і структурних літер {}[]:, у 64 байтах від block
+inline void neon_json_masks(const char* block, uint64_t& quote, uint64_t& backslash, uint64_t& structural) {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(block);
+    uint8x16_t quotes[4];
+    uint8x16_t backslashes[4];
+    uint8x16_t structurals[4];
+    for (size_t part = 0; part < 4; ++part) {
+        uint8x16_t data = vld1q_u8(ptr + 16 * part);
+        uint8x16_t hits = vorrq_u8(vceqq_u8(data, vdupq_n_u8('{')), vceqq_u8(data, vdupq_n_u8('}')));
+        hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8('[')));
+        hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8(']')));
+        hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8(':')));
+        hits = vorrq_u8(hits, vceqq_u8(data, vdupq_n_u8(',')));
+        quotes[part] = vceqq_u8(data, vdupq_n_u8('"'));
+        backslashes[part] = vceqq_u8(data, vdupq_n_u8('\\'));
+        structurals[part] = hits;
+    }
+    quote = neon_bitmask64(quotes[0], quotes[1], quotes[2], quotes[3]);
+    backslash = neon_bitmask64(backslashes[0], backslashes[1], backslashes[2], backslashes[3]);
+    structural = neon_bitmask64(structurals[0], structurals[1], structurals[2], structurals[3]);
+}
+
+//! індексує [src, src + size) блоками по 64 байти: лапки без екрану
+//! відкривають і закривають рядки, а структурні літери всередині рядків
+//! відкидає маска, отримана префіксним XOR. Неповний останній блок
+//! доповнюється пробілами. Повертає false, якщо рядок не закрито
+inline bool neon_json_index(const char* src, size_t size, std::vector<size_t>& out) {
+    out.clear();
+    uint64_t prev_escaped = 0;
+    uint64_t prev_in_string = 0;
+    alignas(32) char tail[64];
+    for (size_t i = 0; i < size; i += 64) {
+        const char* block = src + i;
+        if (size - i < 64) {
+            std::memset(tail, ' ', 64);
+            std::memcpy(tail, src + i, size - i);
+            block = tail;
+        }
+        uint64_t quote = 0;
+        uint64_t backslash = 0;
+        uint64_t structural = 0;
+        neon_json_masks(block, quote, backslash, structural);
+        quote &= ~json_escaped_mask(backslash, prev_escaped);
+        uint64_t const in_string = prefix_xor(quote) ^ prev_in_string;
+        prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+        uint64_t bits = (structural & ~in_string) | quote;
+        while (bits != 0) {
+            out.push_back(i + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+    }
+    return prev_in_string == 0;
+}
+
+//! маски лапок і роздільників полів (delimiter чи '\n') у 64 байтах від
+//! block; біти за межами тексту відкидаються
+inline void neon_csv_masks(const char* src, size_t size, size_t block, char delimiter, uint64_t& quote, uint64_t& separator) {
+    alignas(16) char tail[64];
+    const char* ptr = src + block;
+    size_t const left = size - block;
+    if (left < 64) {
+        std::memset(tail, 0, 64);
+        std::memcpy(tail, ptr, left);
+        ptr = tail;
+    }
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(ptr);
+    uint8x16_t quotes[4];
+    uint8x16_t separators[4];
+    for (size_t part = 0; part < 4; ++part) {
+        uint8x16_t data = vld1q_u8(bytes + 16 * part);
+        quotes[part] = vceqq_u8(data, vdupq_n_u8('"'));
+        separators[part] = vorrq_u8(vceqq_u8(data, vdupq_n_u8(static_cast<uint8_t>(delimiter))), vceqq_u8(data, vdupq_n_u8('\n')));
+    }
+    quote = neon_bitmask64(quotes[0], quotes[1], quotes[2], quotes[3]);
+    separator = neon_bitmask64(separators[0], separators[1], separators[2], separators[3]);
+    if (left < 64) {
+        uint64_t const valid = (uint64_t(1) << left) - 1;
+        quote &= valid;
+        separator &= valid;
+    }
+}
+
+//! таблиця left-pack для 8 байтів: рядок m -- номери байтів, чиї біти
+//! в m встановлені, підряд від молодшого; решта рядка -- 0x80, що обнуляє байт
+//! і в pshufb, і в tbl
+struct left_pack_table {
+    uint8_t indices[256][8];
+
+    constexpr left_pack_table() : indices() {
+        for (size_t m = 0; m < 256; ++m) {
+            size_t n = 0;
+            for (size_t bit = 0; bit < 8; ++bit) {
+                if ((m >> bit) & 1) {
+                    indices[m][n++] = static_cast<uint8_t>(bit);
+                }
+            }
+            for (; n < 8; ++n) {
+                indices[m][n] = 0x80;
+            }
+        }
+    }
+};
+
+alignas(16) constexpr left_pack_table left_pack{};
+
+//! left-pack 16 байтів block за маскою keep у dst через tbl по 8 байтів;
+//! повертає кількість записаних байтів. Записи не виходять за межі вже
+//! прочитаного блоку, тож dst може відставати від джерела в тому самому буфері
+inline size_t neon_left_pack(uint8x16_t block, unsigned keep, char* dst) {
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+    unsigned const low = keep & 0xFF;
+    unsigned const high = (keep >> 8) & 0xFF;
+    vst1_u8(out, vtbl1_u8(vget_low_u8(block), vld1_u8(left_pack.indices[low])));
+    size_t const written = __builtin_popcount(low);
+    vst1_u8(out + written, vtbl1_u8(vget_high_u8(block), vld1_u8(left_pack.indices[high])));
+    return written + __builtin_popcount(high);
+}
+
+//! стискає кожну серію ASCII-пробілів у [src, src + size) до одного ' ' і
+//! обрізає їх на початку й у кінці; повертає новий розмір. Пробіли блоку
+//! замінюються на ' ', а маска "пробіл після пробілу" відкидає зайві left-pack'ом.
+//! dst може дорівнювати src: запис ніколи не випереджає прочитане
+inline size_t neon_collapse_whitespace(const char* src, size_t size, char* dst) {
+    size_t written = 0;
+    uint64_t prev_space = 1; // пробіли на початку відкидаються
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src + i);
+        uint8x16_t blocks[4];
+        uint8x16_t spaces[4];
+        for (size_t part = 0; part < 4; ++part) {
+            blocks[part] = vld1q_u8(ptr + 16 * part);
+            spaces[part] = neon_space_bytes(blocks[part]);
+            blocks[part] = vbslq_u8(spaces[part], vdupq_n_u8(' '), blocks[part]);
+        }
+        uint64_t const space = neon_bitmask64(spaces[0], spaces[1], spaces[2], spaces[3]);
+        uint64_t const keep = ~(space & ((space << 1) | prev_space));
+        prev_space = space >> 63;
+        for (size_t part = 0; part < 4; ++part) {
+            written += neon_left_pack(blocks[part], static_cast<unsigned>(keep >> (16 * part)) & 0xFFFF, dst + written);
+        }
+    }
+    for (; i < size; ++i) {
+        bool const space = is_ascii_space(src[i]);
+        if (!space || !prev_space) {
+            dst[written++] = space ? ' ' : src[i];
+        }
+        prev_space = space;
+    }
+    if (prev_space && written > 0) {
+        --written;
+    }
+    return written;
+}
+
+//! довільний набір байтів як дві таблиці по 16 байтів (перевірка належності
+//! за Muła): low[n] має біт h, якщо байт (h << 4) | n у наборі для h < 8,
+//! high[n] -- те саме для h >= 8. Рядок вибирає молодший півбайт, біт -- старший
+struct byte_set {
+    alignas(16) uint8_t low[16];
+    alignas(16) uint8_t high[16];
+};
+
+inline byte_set make_byte_set(const char* set, size_t size) {
+    byte_set result = {};
+    for (size_t i = 0; i < size; ++i) {
+        unsigned const byte = static_cast<unsigned char>(set[i]);
+        uint8_t* rows = byte < 0x80 ? result.low : result.high;
+        rows[byte & 0x0F] |= static_cast<uint8_t>(1u << ((byte >> 4) & 7));
+    }
+    return result;
+}
+
+inline bool byte_set_contains(const byte_set& set, char c) {
+    unsigned const byte = static_cast<unsigned char>(c);
+    const uint8_t* rows = byte < 0x80 ? set.low : set.high;
+    return (rows[byte & 0x0F] >> ((byte >> 4) & 7)) & 1;
+}
+
+//! 0xFF у байтах data, що належать набору (таблиці low і high з byte_set):
+//! tbl за молодшим півбайтом дає рядок, старший біт байта вибирає таблицю,
+//! а другий tbl -- біт старшого півбайта
+inline uint8x16_t neon_set_bytes(uint8x16_t data, uint8x16_t low, uint8x16_t high) {
+    static constexpr uint8_t bit_values[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t const lo = vandq_u8(data, vdupq_n_u8(0x0F));
+    uint8x16_t const hi = vshrq_n_u8(data, 4);
+    uint8x16_t const rows = vbslq_u8(vcgeq_u8(data, vdupq_n_u8(0x80)), vqtbl1q_u8(high, lo), vqtbl1q_u8(low, lo));
+    uint8x16_t const bits = vqtbl1q_u8(vld1q_u8(bit_values), hi);
+    return vtstq_u8(rows, bits);
+}
+
+//! викидає з [src, src + size) байти, для яких hits(блок) дає 0xFF (хвіст --
+//! is_removed), і left-pack'ом збирає решту в dst; повертає новий розмір.
+//! dst може дорівнювати src, тож це один лінійний прохід замість erase на байт
+template <typename Hits, typename IsRemoved>
+inline size_t neon_remove_if(const char* src, size_t size, char* dst, Hits hits, IsRemoved is_removed) {
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src + i);
+        uint8x16_t blocks[4];
+        uint8x16_t removed[4];
+        for (size_t part = 0; part < 4; ++part) {
+            blocks[part] = vld1q_u8(ptr + 16 * part);
+            removed[part] = hits(blocks[part]);
+        }
+        uint64_t const keep = ~neon_bitmask64(removed[0], removed[1], removed[2], removed[3]);
+        for (size_t part = 0; part < 4; ++part) {
+            written += neon_left_pack(blocks[part], static_cast<unsigned>(keep >> (16 * part)) & 0xFFFF, dst + written);
+        }
+    }
+    for (; i < size; ++i) {
+        if (!is_removed(src[i])) {
+            dst[written++] = src[i];
+        }
+    }
+    return written;
+}
+
+//! Доступ до буфера читання streambuf без проміжних копій. gptr/egptr/gbump
+//! захищені, але вказівник на член, взятий через похідний клас, можна
+//! легально викликати на будь-якому std::streambuf.
+struct streambuf_window : std::streambuf {
+    static const char* begin(std::streambuf* sb) { return (sb->*&streambuf_window::gptr)(); }
+    static const char* end(std::streambuf* sb) { return (sb->*&streambuf_window::egptr)(); }
+    static void consume(std::streambuf* sb, size_t n) {
+        (sb->*&streambuf_window::gbump)(static_cast<int>(n));
+    }
+};
+
+//! Проходить буфер sb цілими блоками: find_stop шукає в блоці літеру-зупинку,
+//! усе перед нею віддається в sink одним шматком. Сама зупинка лишається в
+//! потоці. Повертає false, якщо потік закінчився раніше за зупинку.
+template <typename Finder, typename Sink>
+static bool scan_streambuf(std::streambuf* sb, Finder find_stop, Sink sink) {
+    for (;;) {
+        const char* begin = streambuf_window::begin(sb);
+        const char* end = streambuf_window::end(sb);
+        if (begin == end) {
+            int const c = sb->sgetc();
+            if (c == std::char_traits<char>::eof()) {
+                return false;
+            }
+            if (streambuf_window::begin(sb) == streambuf_window::end(sb)) {
+                // небуферизований потік (напр. std::cin з sync_with_stdio) -- по одній літері
+                char const ch = std::char_traits<char>::to_char_type(c);
+                if (find_stop(&ch, 1) == 0) {
+                    return true;
+                }
+                sink(&ch, 1);
+                sb->sbumpc();
+            }
+            continue;
+        }
+        size_t const size = end - begin;
+        size_t const pos = find_stop(begin, size);
+        sink(begin, pos);
+        streambuf_window::consume(sb, pos);
+        if (pos < size) {
+            return true;
+        }
+    }
+}
 
 //! допоміжний конструктор. Аналогічний як ПОК лабі
 my_str_simd::my_str_simd(size_t const capacity):
@@ -114,6 +1667,23 @@ my_str_simd::my_str_simd(const std::string& str) {
     // '\0' у кінці
 }
 
+//! АКС
+//! копіює вміст view; місткість -- рівно під дані
+my_str_simd::my_str_simd(const my_str_simd_view& view) {
+    size_m = view.size();
+    capacity_m = size_m + 1;
+    data_m = new char[capacity_m];
+    neon_memcpy(view.data(), data_m, size_m);
+    data_m[size_m] = '\0';
+}
+
+//! АКС
+my_str_simd::my_str_simd(const my_str_simd_view& view, validate_utf8_t) : my_str_simd(view) {
+    if (!neon_is_valid_utf8(data_m, size_m)) {
+        throw std::invalid_argument("my_str_simd: invalid UTF-8");
+    }
+}
+
 //! конструктор копій
 //! ПОК
 // my_str_simd::my_str_simd(const my_str_simd & mystr):
@@ -534,22 +2104,37 @@ void my_str_simd::insert(size_t idx, const char* cstr) {
 }
 
 
-//! POK by Lev Lysyk
-//! немає потреби у сімд, бо інсерт вже має сімд обчислення
-void my_str_simd::append(char c) {
-    insert(size_m, c);
+//! АКС
+//! дописування масиву байт відомої довжини: одна перевірка місткості і
+//! одне векторне копіювання, без strlen і без зсуву хвоста через insert
+void my_str_simd::append(const char* cstr, size_t len) {
+    if (len == 0) return;
+    if (size_m + len + 1 > capacity_m) {
+        // cstr може бути частиною нашого ж буфера, який reserve звільнить
+        bool const aliased = cstr >= data_m && cstr < data_m + capacity_m;
+        size_t const offset = cstr - data_m;
+        reserve(2 * (size_m + len) + 1);
+        if (aliased) {
+            cstr = data_m + offset;
+        }
+    }
+    neon_memcpy(cstr, data_m + size_m, len);
+    size_m += len;
+    data_m[size_m] = '\0';
 }
 
-//! ПОК by Oksana Kotliarchuk
-//! немає потреби у сімд, бо інсерт вже має сімд обчислення
+//! АКС
 void my_str_simd::append (const my_str_simd& str) {
-    insert(size_m, str);
+    append(str.data_m, str.size_m);
 }
 
-//! ПОК by Oksana Kotliarchuk
-//! немає потреби у сімд, бо інсерт вже має сімд обчислення
+//! АКС
+//! один strlen, далі -- той самий шлях, що й для відомої довжини
 void my_str_simd::append (const char* cstr) {
-    insert(size_m, cstr);
+    if (cstr == nullptr) {
+        throw std::logic_error("Null pointer passed to append()");
+    }
+    append(cstr, std::strlen(cstr));
 }
 
 //! ПОК by Oksana Kotliarchuk
@@ -621,26 +2206,8 @@ size_t my_str_simd::find(char c, size_t idx) const {
     if (idx > size_m) {
         throw std::out_of_range("my_str_simd::find");
     }
-    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data_m);
-    uint8_t target = static_cast<uint8_t>(c);
-    uint8x16_t target_vector = vdupq_n_u8(target);
-    size_t i = idx;
-    for (; i + 16 <= size_m; i += 16) {
-        uint8x16_t data_vector = vld1q_u8(ptr + i);
-        uint8x16_t cmp = vceqq_u8(data_vector, target_vector);
-        // порівняння
-        uint8_t cmp_array[16];
-        vst1q_u8(cmp_array, cmp);
-        for (int j = 0; j < 16; ++j) {
-            if (cmp_array[j] == 0xFF) {
-                return i + j;
-            }
-        }
-    }
-    for (; i < size_m; ++i) {
-        if (ptr[i] == target) {
-            return i;}}
-    return not_found;
+    size_t const pos = neon_find_char(data_m + idx, size_m - idx, c);
+    return (pos == size_m - idx) ? not_found : idx + pos;
 }
 
 
@@ -672,57 +2239,7 @@ size_t my_str_simd::find(const std::string& str, size_t idx) const {
     if (idx > size_m) {
         throw std::out_of_range("my_str_simd::find");
     }
-    size_t str_len = str.size();
-    if (str_len == 0) {
-        return idx;
-    }
-    if (str_len > size_m - idx) {
-        return not_found;
-    }
-    const uint8_t* src = reinterpret_cast<const uint8_t*>(data_m);
-    const uint8_t target = static_cast<uint8_t>(str[0]);
-    const uint8x16_t target_vector = vdupq_n_u8(target);
-    size_t i = idx;
-    for (; i + 16 <= size_m; i += 16) {
-        const uint8x16_t block = vld1q_u8(src + i);
-        const uint8x16_t cmp = vceqq_u8(block, target_vector);
-        uint8_t cmp_array[16];
-        vst1q_u8(cmp_array, cmp);
-        for (int j = 0; j < 16; ++j) {
-            if (cmp_array[j] == 0xFF) {
-                size_t candidate = i + j;
-                if (candidate + str_len <= size_m) {
-                    bool matched = true;
-                    for (size_t k = 0; k < str_len; ++k) {
-                        if (data_m[candidate + k] != str[k]) {
-                            matched = false;
-                            break;
-                        }
-                    }
-                    if (matched) {
-                        return candidate;
-                    }
-                }
-            }
-        }
-    }
-    for (; i < size_m; ++i) {
-        if (data_m[i] == str[0]) {
-            if (i + str_len <= size_m) {
-                bool matched = true;
-                for (size_t k = 0; k < str_len; ++k) {
-                    if (data_m[i + k] != str[k]) {
-                        matched = false;
-                        break;
-                    }
-                }
-                if (matched) {
-                    return i;
-                }
-            }
-        }
-    }
-    return not_found;
+    return neon_find_str(data_m, size_m, str.data(), str.size(), idx);
 }
 
 
@@ -757,58 +2274,452 @@ size_t my_str_simd::find(const char* cstr, size_t idx) const {
     if (idx > size_m) {
         throw std::out_of_range("my_str_simd::find");
     }
+    return neon_find_str(data_m, size_m, cstr, std::strlen(cstr), idx);
+}
 
-    size_t str_len = std::strlen(cstr);
-    if (str_len == 0) {
-        return idx;
+//! Aks version
+void my_str_simd::split(char delim, std::vector<my_str_simd_view>& out) const {
+    my_str_simd_view(*this).split(delim, out);
+}
+
+//! Aks version
+void my_str_simd::split_any(my_str_simd_view charset, std::vector<my_str_simd_view>& out) const {
+    my_str_simd_view(*this).split_any(charset, out);
+}
+
+//! АКС
+my_str_simd my_str_simd::concat(std::initializer_list<my_str_simd_view> pieces) {
+    return join(pieces);
+}
+
+//! АКС
+void my_str_simd::to_upper() {
+    neon_flip_case(data_m, data_m, size_m, 'a', 'z');
+}
+
+//! АКС
+void my_str_simd::to_lower() {
+    neon_flip_case(data_m, data_m, size_m, 'A', 'Z');
+}
+
+//! АКС
+my_str_simd my_str_simd::to_upper_copy() const {
+    my_str_simd result;
+    result.reserve(size_m + 1);
+    neon_flip_case(data_m, result.data_m, size_m, 'a', 'z');
+    result.size_m = size_m;
+    result.data_m[size_m] = '\0';
+    return result;
+}
+
+//! АКС
+my_str_simd my_str_simd::to_lower_copy() const {
+    my_str_simd result;
+    result.reserve(size_m + 1);
+    neon_flip_case(data_m, result.data_m, size_m, 'A', 'Z');
+    result.size_m = size_m;
+    result.data_m[size_m] = '\0';
+    return result;
+}
+
+//! АКС
+void my_str_simd::ltrim() {
+    my_str_simd_view const rest = my_str_simd_view(*this).ltrim();
+    std::memmove(data_m, rest.data(), rest.size());
+    size_m = rest.size();
+    data_m[size_m] = '\0';
+}
+
+//! АКС
+void my_str_simd::rtrim() {
+    size_m = my_str_simd_view(*this).rtrim().size();
+    data_m[size_m] = '\0';
+}
+
+//! АКС
+void my_str_simd::trim() {
+    rtrim();
+    ltrim();
+}
+
+//! АКС
+my_str_simd my_str_simd::ltrim_copy() const {
+    return my_str_simd(my_str_simd_view(*this).ltrim());
+}
+
+//! АКС
+my_str_simd my_str_simd::rtrim_copy() const {
+    return my_str_simd(my_str_simd_view(*this).rtrim());
+}
+
+//! АКС
+my_str_simd my_str_simd::trim_copy() const {
+    return my_str_simd(my_str_simd_view(*this).trim());
+}
+
+void my_str_simd::collapse_whitespace() {
+    size_m = neon_collapse_whitespace(data_m, size_m, data_m);
+    data_m[size_m] = '\0';
+}
+
+my_str_simd my_str_simd::collapse_whitespace_copy() const {
+    my_str_simd result;
+    result.reserve(size_m + 1);
+    result.size_m = neon_collapse_whitespace(data_m, size_m, result.data_m);
+    result.data_m[result.size_m] = '\0';
+    return result;
+}
+
+void my_str_simd::remove(char c) {
+    uint8x16_t const target = vdupq_n_u8(static_cast<uint8_t>(c));
+    size_m = neon_remove_if(data_m, size_m, data_m,
+        [target](uint8x16_t block) { return vceqq_u8(block, target); },
+        [c](char byte) { return byte == c; });
+    data_m[size_m] = '\0';
+}
+
+void my_str_simd::remove_any(my_str_simd_view charset) {
+    byte_set const set = make_byte_set(charset.data(), charset.size());
+    uint8x16_t const low = vld1q_u8(set.low);
+    uint8x16_t const high = vld1q_u8(set.high);
+    size_m = neon_remove_if(data_m, size_m, data_m,
+        [low, high](uint8x16_t block) { return neon_set_bytes(block, low, high); },
+        [&set](char byte) { return byte_set_contains(set, byte); });
+    data_m[size_m] = '\0';
+}
+
+//! АКС
+void my_str_simd::replace(size_t pos, size_t len, my_str_simd_view str) {
+    if (pos > size_m) {
+        throw std::out_of_range("my_str_simd::replace");
+    }
+    if (len > size_m - pos) {
+        len = size_m - pos;
+    }
+    size_t const tail = size_m - pos - len;
+    size_t const new_size = size_m - len + str.size();
+    std::less<const char*> const before;
+    bool const aliased = !before(str.data(), data_m) && before(str.data(), data_m + capacity_m);
+    if (new_size + 1 > capacity_m || aliased) {
+        size_t const new_capacity = (new_size + 1 > capacity_m) ? 2 * new_size + 1 : capacity_m;
+        char* new_data = new char[new_capacity];
+        neon_memcpy(data_m, new_data, pos);
+        neon_memcpy(str.data(), new_data + pos, str.size());
+        neon_memcpy(data_m + pos + len, new_data + pos + str.size(), tail);
+        delete[] data_m;
+        data_m = new_data;
+        capacity_m = new_capacity;
+    } else {
+        std::memmove(data_m + pos + str.size(), data_m + pos + len, tail);
+        neon_memcpy(str.data(), data_m + pos, str.size());
     }
-    if (str_len > size_m - idx) {
-        return not_found;
+    size_m = new_size;
+    data_m[size_m] = '\0';
+}
+
+//! АКС
+size_t my_str_simd::replace_all(my_str_simd_view from, my_str_simd_view to) {
+    if (from.empty()) {
+        return 0;
+    }
+    std::vector<size_t> matches;
+    for (size_t pos = neon_find_str(data_m, size_m, from.data(), from.size(), 0); pos != not_found;
+         pos = neon_find_str(data_m, size_m, from.data(), from.size(), pos + from.size())) {
+        matches.push_back(pos);
+    }
+    if (matches.empty()) {
+        return 0;
+    }
+    size_t const new_size = size_m - matches.size() * from.size() + matches.size() * to.size();
+    std::less<const char*> const before;
+    bool const aliased = !before(to.data(), data_m) && before(to.data(), data_m + capacity_m);
+    // Коротша заміна пишеться на місці: запис не обганяє читання, а пряме
+    // копіювання блоками вперед безпечне, коли dst <= src.
+    bool const in_place = to.size() <= from.size() && !aliased;
+    char* out = in_place ? data_m : new char[new_size + 1];
+    size_t read = 0;
+    size_t write = 0;
+    for (size_t match : matches) {
+        neon_memcpy(data_m + read, out + write, match - read);
+        write += match - read;
+        neon_memcpy(to.data(), out + write, to.size());
+        write += to.size();
+        read = match + from.size();
+    }
+    neon_memcpy(data_m + read, out + write, size_m - read);
+    if (!in_place) {
+        delete[] data_m;
+        data_m = out;
+        capacity_m = new_size + 1;
     }
-    const uint8_t* src = reinterpret_cast<const uint8_t*>(data_m);
-    uint8_t target = static_cast<uint8_t>(cstr[0]);
-    uint8x16_t target_vector = vdupq_n_u8(target);
-    size_t i = idx;
-    for (; i + 16 <= size_m; i += 16) {
-        uint8x16_t block = vld1q_u8(src + i);
-        uint8x16_t cmp = vceqq_u8(block, target_vector);
-        uint8_t cmp_array[16];
-        vst1q_u8(cmp_array, cmp);
-        for (int j = 0; j < 16; ++j) {
-            if (cmp_array[j] == 0xFF) {
-                size_t candidate = i + j;
-                if (candidate + str_len <= size_m) {
-                    bool matched = true;
-                    for (size_t k = 0; k < str_len; ++k) {
-                        if (data_m[candidate + k] != cstr[k]) {
-                            matched = false;
-                            break;
-                        }
-                    }
-                    if (matched) {
-                        return candidate;
-                    }
-                }
-            }
+    size_m = new_size;
+    data_m[size_m] = '\0';
+    return matches.size();
+}
+
+//! АКС
+void my_str_simd::translate(const uint8_t table[256]) {
+    neon_translate(data_m, size_m, table);
+}
+
+//! АКС
+bool my_str_simd::is_valid_utf8() const {
+    return neon_is_valid_utf8(data_m, size_m);
+}
+
+//! АКС
+size_t my_str_simd::utf8_length() const {
+    return my_str_simd_view(*this).utf8_length();
+}
+
+//! АКС
+size_t my_str_simd::utf8_offset(size_t n) const {
+    return my_str_simd_view(*this).utf8_offset(n);
+}
+
+std::u16string my_str_simd::to_utf16() const {
+    return my_str_simd_view(*this).to_utf16();
+}
+
+std::u32string my_str_simd::to_utf32() const {
+    return my_str_simd_view(*this).to_utf32();
+}
+
+size_t my_str_simd::to_utf16(std::u16string& out) const {
+    return my_str_simd_view(*this).to_utf16(out);
+}
+
+size_t my_str_simd::to_utf32(std::u32string& out) const {
+    return my_str_simd_view(*this).to_utf32(out);
+}
+
+my_str_simd my_str_simd::from_utf16(const char16_t* src, size_t size) {
+    my_str_simd result;
+    result.reserve(3 * size + 1);
+    size_t written = 0;
+    size_t const bad = neon_utf16_to_utf8(src, size, result.data_m, written);
+    if (bad != not_found) {
+        throw std::invalid_argument("my_str_simd::from_utf16: unpaired surrogate at " + std::to_string(bad));
+    }
+    result.size_m = written;
+    result.data_m[written] = '\0';
+    return result;
+}
+
+my_str_simd my_str_simd::from_utf16(const std::u16string& src) {
+    return from_utf16(src.data(), src.size());
+}
+
+my_str_simd my_str_simd::from_utf32(const char32_t* src, size_t size) {
+    my_str_simd result;
+    result.reserve(4 * size + 1);
+    size_t written = 0;
+    size_t const bad = neon_utf32_to_utf8(src, size, result.data_m, written);
+    if (bad != not_found) {
+        throw std::invalid_argument("my_str_simd::from_utf32: invalid code point at " + std::to_string(bad));
+    }
+    result.size_m = written;
+    result.data_m[written] = '\0';
+    return result;
+}
+
+my_str_simd my_str_simd::from_utf32(const std::u32string& src) {
+    return from_utf32(src.data(), src.size());
+}
+
+my_str_simd my_str_simd::base64_encode() const {
+    my_str_simd result;
+    size_t const encoded = (size_m + 2) / 3 * 4;
+    result.reserve(encoded + 1);
+    neon_base64_encode(data_m, size_m, result.data_m);
+    result.size_m = encoded;
+    result.data_m[encoded] = '\0';
+    return result;
+}
+
+my_str_simd my_str_simd::base64_decode(base64_mode mode) const {
+    const char* src = data_m;
+    size_t size = size_m;
+    std::string compact;
+    if (mode == base64_mode::lenient && neon_find_space(src, size) != size) {
+        compact.reserve(size);
+        for (size_t pos = 0; pos < size;) {
+            size_t const run = neon_find_space(src + pos, size - pos);
+            compact.append(src + pos, run);
+            pos += run;
+            pos += neon_find_space(src + pos, size - pos, false);
         }
+        src = compact.data();
+        size = compact.size();
     }
-    for (; i < size_m; ++i) {
-        if (data_m[i] == cstr[0]) {
-            if (i + str_len <= size_m) {
-                bool matched = true;
-                for (size_t k = 0; k < str_len; ++k) {
-                    if (data_m[i + k] != cstr[k]) {
-                        matched = false;
-                        break;
-                    }
-                }
-                if (matched) {
-                    return i;
-                }
-            }
+    if (mode == base64_mode::strict && size % 4 != 0) {
+        throw std::invalid_argument("my_str_simd::base64_decode: length is not a multiple of 4");
+    }
+    size_t body = size;
+    for (size_t k = 0; k < 2 && body > 0 && src[body - 1] == '='; ++k) {
+        --body;
+    }
+    size_t const tail = body % 4;
+    if (tail == 1) {
+        throw std::invalid_argument("my_str_simd::base64_decode: truncated input");
+    }
+    size_t const decoded = body / 4 * 3 + (tail == 0 ? 0 : tail - 1);
+    my_str_simd result;
+    result.reserve(decoded + 1);
+    size_t written = 0;
+    size_t const bad = neon_base64_decode(src, body, result.data_m, written);
+    if (bad != not_found) {
+        throw std::invalid_argument("my_str_simd::base64_decode: invalid character at " + std::to_string(bad));
+    }
+    if (mode == base64_mode::strict && tail != 0 && (base64_value(src[body - 1]) & (tail == 2 ? 0x0F : 0x03)) != 0) {
+        throw std::invalid_argument("my_str_simd::base64_decode: non-zero trailing bits");
+    }
+    result.size_m = decoded;
+    result.data_m[decoded] = '\0';
+    return result;
+}
+
+my_str_simd my_str_simd::to_hex() const {
+    my_str_simd result;
+    result.reserve(2 * size_m + 1);
+    neon_hex_encode(data_m, size_m, result.data_m);
+    result.size_m = 2 * size_m;
+    result.data_m[result.size_m] = '\0';
+    return result;
+}
+
+my_str_simd my_str_simd::from_hex(my_str_simd_view hex) {
+    if (hex.size() % 2 != 0) {
+        throw std::invalid_argument("my_str_simd::from_hex: odd number of digits");
+    }
+    my_str_simd result;
+    result.reserve(hex.size() / 2 + 1);
+    size_t const bad = neon_hex_decode(hex.data(), hex.size(), result.data_m);
+    if (bad != not_found) {
+        throw std::invalid_argument("my_str_simd::from_hex: invalid digit at " + std::to_string(bad));
+    }
+    result.size_m = hex.size() / 2;
+    result.data_m[result.size_m] = '\0';
+    return result;
+}
+
+my_str_simd my_str_simd::escape_json() const {
+    my_str_simd result;
+    result.reserve(size_m + size_m / 8 + 1);
+    neon_escape(data_m, size_m, neon_json_special_mask, is_json_special, json_escape_char<my_str_simd>, result);
+    return result;
+}
+
+my_str_simd my_str_simd::escape_html() const {
+    my_str_simd result;
+    result.reserve(size_m + size_m / 8 + 1);
+    neon_escape(data_m, size_m, neon_html_special_mask, is_html_special, html_escape_char<my_str_simd>, result);
+    return result;
+}
+
+my_str_simd my_str_simd::escape_csv() const {
+    if (neon_find_special(data_m, size_m, neon_csv_special_mask, is_csv_special) == size_m) {
+        return *this;
+    }
+    my_str_simd result;
+    result.reserve(size_m + size_m / 8 + 3);
+    result.append('"');
+    neon_escape(data_m, size_m, neon_quote_mask,
+        [](char c) { return c == '"'; },
+        [](my_str_simd& out, char) { out.append("\"\"", 2); },
+        result);
+    result.append('"');
+    return result;
+}
+
+my_str_simd my_str_simd::url_decode(bool plus_as_space) const {
+    my_str_simd result;
+    result.reserve(size_m + 1);
+    size_t pos = 0;
+    while (pos < size_m) {
+        size_t const next = pos + (plus_as_space ? neon_find_any_of(data_m + pos, size_m - pos, "%+")
+                                                 : neon_find_char(data_m + pos, size_m - pos, '%'));
+        result.append(data_m + pos, next - pos);
+        if (next == size_m) {
+            break;
+        }
+        if (data_m[next] == '+') {
+            result.append(' ');
+            pos = next + 1;
+            continue;
         }
+        uint8_t const high = (next + 2 < size_m) ? hex_value(data_m[next + 1]) : 0xFF;
+        uint8_t const low = (high != 0xFF) ? hex_value(data_m[next + 2]) : 0xFF;
+        if (low == 0xFF) {
+            throw std::invalid_argument("my_str_simd::url_decode: malformed escape at " + std::to_string(next));
+        }
+        result.append(static_cast<char>((high << 4) | low));
+        pos = next + 3;
+    }
+    return result;
+}
+
+my_str_simd_url my_str_simd::parse_url() const {
+    return my_str_simd_view(*this).parse_url();
+}
+
+int64_t my_str_simd::to_int64() const {
+    return my_str_simd_view(*this).to_int64();
+}
+
+uint64_t my_str_simd::to_uint64() const {
+    return my_str_simd_view(*this).to_uint64();
+}
+
+void my_str_simd::append_int(int64_t value) {
+    char digits[21];
+    uint64_t const magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    size_t length = format_uint(magnitude, digits + 21);
+    if (value < 0) {
+        digits[20 - length++] = '-';
     }
-    return not_found;
+    append(digits + 21 - length, length);
+}
+
+void my_str_simd::append_uint(uint64_t value) {
+    char digits[20];
+    size_t const length = format_uint(value, digits + 20);
+    append(digits + 20 - length, length);
+}
+
+my_str_simd my_str_simd::from_int(int64_t value) {
+    my_str_simd result;
+    result.reserve(21);
+    result.append_int(value);
+    return result;
+}
+
+my_str_simd my_str_simd::from_uint(uint64_t value) {
+    my_str_simd result;
+    result.reserve(21);
+    result.append_uint(value);
+    return result;
+}
+
+double my_str_simd::to_double() const {
+    return my_str_simd_view(*this).to_double();
+}
+
+void my_str_simd::json_index(std::vector<size_t>& out) const {
+    my_str_simd_view(*this).json_index(out);
+}
+
+void my_str_simd::append_double(double value) {
+    char digits[32];
+    std::to_chars_result const result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, static_cast<size_t>(result.ptr - digits));
+}
+
+my_str_simd my_str_simd::from_double(double value) {
+    my_str_simd result;
+    result.reserve(32);
+    result.append_double(value);
+    return result;
 }
 
 //! POK by Lev Lysyk
@@ -874,26 +2785,56 @@ std::ostream& operator<<(std::ostream& stream, const my_str_simd& str) {
     stream << str.c_str();
     return stream; }
 
-//! POK by Lev Lysyk
-//! немає потреби у СІМД обчисленнчх
+//! АКС
+//! Слово читається цілими шматками буфера потоку: межу шукає SIMD-класифікатор
+//! пробільних літер, а знайдений шматок дописується одним векторним копіюванням.
 std::istream& operator>>(std::istream& stream, my_str_simd& str) {
-    while (std::isspace(stream.get())) {}
-    stream.unget();
+    std::istream::sentry guard(stream, true);
+    if (!guard) {
+        return stream;
+    }
     str.clear();
-    while (!std::isspace(stream.peek()) && !stream.eof() && !stream.fail())
-    {
-        str.append(static_cast<char>(stream.get()));
+    std::streambuf* sb = stream.rdbuf();
+    auto find_word = [](const char* src, size_t size) { return neon_find_space(src, size, false); };
+    auto find_blank = [](const char* src, size_t size) { return neon_find_space(src, size, true); };
+    auto skip = [](const char*, size_t) {};
+    auto append = [&str](const char* src, size_t size) { str.append(src, size); };
+
+    bool more = true;
+    if (stream.flags() & std::ios_base::skipws) {
+        more = scan_streambuf(sb, find_word, skip);
+    }
+    if (more) {
+        more = scan_streambuf(sb, find_blank, append);
+    }
+    std::ios_base::iostate state = more ? std::ios_base::goodbit : std::ios_base::eofbit;
+    if (str.size() == 0) {
+        state |= std::ios_base::failbit;
     }
+    stream.setstate(state);
     return stream;
 }
 
-//! POK by Lev Lysyk
-//! немає потреби у СІМД обчисленнч
+//! АКС
+//! Як std::getline: '\n' забирається з потоку, але не потрапляє в str.
+//! Рядок без '\n' в кінці файлу повертається з eofbit; failbit -- лише
+//! якщо не прочитано жодної літери.
 std::istream& readline(std::istream& stream, my_str_simd& str) {
     str.clear();
-    for (size_t i = 0; stream.peek() != '\n'; i++)
-    {
-        str.append(static_cast<char>(stream.get()));
+    std::istream::sentry guard(stream, true);
+    if (!guard) {
+        return stream;
+    }
+    std::streambuf* sb = stream.rdbuf();
+    auto find_newline = [](const char* src, size_t size) { return neon_find_char(src, size, '\n'); };
+    auto append = [&str](const char* src, size_t size) { str.append(src, size); };
+
+    if (scan_streambuf(sb, find_newline, append)) {
+        sb->sbumpc();
+    } else if (str.size() == 0) {
+        stream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+    } else {
+        stream.setstate(std::ios_base::eofbit);
     }
     return stream;
 }
@@ -910,42 +2851,11 @@ std::istream& readline(std::istream& stream, my_str_simd& str) {
 
 //! AKS by Maksym Dzoban
 //! приймає на вхід 2 обєкти мого класу і порівнює
-bool operator==(const my_str_simd &str1, const my_str_simd &str2) {
+bool operator==(const my_str_simd& str1, const my_str_simd& str2) {
     if (str1.size() != str2.size()) {
         return false;
     }
-    size_t size = str1.size();
-    const uint8_t* p1 = reinterpret_cast<const uint8_t*>(str1.c_str());
-    const uint8_t* p2 = reinterpret_cast<const uint8_t*>(str2.c_str());
-    size_t i = 0;
-    for (; i + 32 <= size; i += 32) {
-        uint8x16_t v1_0 = vld1q_u8(p1 + i);
-        uint8x16_t v2_0 = vld1q_u8(p2 + i);
-        uint8x16_t v1_1 = vld1q_u8(p1 + i + 16);
-        uint8x16_t v2_1 = vld1q_u8(p2 + i + 16);
-        uint8x16_t cmp0 = vceqq_u8(v1_0, v2_0);
-        uint8x16_t cmp1 = vceqq_u8(v1_1, v2_1);
-        uint64_t mask0 = vmaxvq_u8(cmp0);
-        uint64_t mask1 = vmaxvq_u8(cmp1);
-        if (mask0 != 255 || mask1 != 255) {
-            return false;
-        }
-    }
-    for (; i + 16 <= size; i += 16) {
-        uint8x16_t v1 = vld1q_u8(p1 + i);
-        uint8x16_t v2 = vld1q_u8(p2 + i);
-        uint8x16_t cmp = vceqq_u8(v1, v2);
-        uint64_t mask = vmaxvq_u8(cmp);
-        if (mask != 255) {
-            return false;
-        }
-    }
-    for (; i < size; ++i) {
-        if (p1[i] != p2[i]) {
-            return false;
-        }
-    }
-    return true;
+    return neon_equal(str1.c_str(), str2.c_str(), str1.size());
 }
 
 //! POK by Maksym Dzoban
@@ -961,47 +2871,14 @@ bool operator==(const my_str_simd &str1, const my_str_simd &str2) {
 //! AKS SIMD by Maksym Dzoban
 //! приймає на всіх 1 обєкс мого класу і 1 с стрічку
 bool operator==(const my_str_simd& str1, const char* cstr2) {
-    if (!cstr2) {return false;}
-    size_t size = str1.size();
-    if (size != std::strlen(cstr2)) {
+    if (!cstr2) {
         return false;
     }
-    const uint8_t* p1 = reinterpret_cast<const uint8_t*>(str1.c_str());
-    const uint8_t* p2 = reinterpret_cast<const uint8_t*>(cstr2);
-    size_t i = 0;
-    for (; i + 32 <= size; i += 32) {
-        uint8x16_t v1_0 = vld1q_u8(p1 + i);
-        uint8x16_t v2_0 = vld1q_u8(p2 + i);
-        uint8x16_t v1_1 = vld1q_u8(p1 + i + 16);
-        uint8x16_t v2_1 = vld1q_u8(p2 + i + 16);
-
-        uint8x16_t cmp0 = vceqq_u8(v1_0, v2_0);
-        uint8x16_t cmp1 = vceqq_u8(v1_1, v2_1);
-
-        uint64_t mask0 = vmaxvq_u8(cmp0);
-        uint64_t mask1 = vmaxvq_u8(cmp1);
-
-        if (mask0 != 255 || mask1 != 255) {
-            return false;
-        }
-    }
-
-    for (; i + 16 <= size; i += 16) {
-        uint8x16_t v1 = vld1q_u8(p1 + i);
-        uint8x16_t v2 = vld1q_u8(p2 + i);
-        uint8x16_t cmp = vceqq_u8(v1, v2);
-        uint64_t mask = vmaxvq_u8(cmp);
-        if (mask != 255) {
-            return false;
-        }
-    }
-
-    for (; i < size; ++i) {
-        if (p1[i] != p2[i]) {
-            return false;
-        }
+    size_t size = str1.size();
+    if (std::strlen(cstr2) != size) {
+        return false;
     }
-    return true;
+    return neon_equal(str1.c_str(), cstr2, size);
 }
 
 //! POK by Maksym Dzoban
@@ -1016,41 +2893,14 @@ bool operator==(const my_str_simd& str1, const char* cstr2) {
 //! AKS by Maksym Dzoban
 //! приймає на вхід 1 c string  і 1 екземпляр класу
 bool operator==(const char* cstr1, const my_str_simd& str2) {
+    if (!cstr1) {
+        return false;
+    }
     size_t size = str2.size();
     if (std::strlen(cstr1) != size) {
-        return false;}
-    const uint8_t* p1 = reinterpret_cast<const uint8_t*>(cstr1);
-    const uint8_t* p2 = reinterpret_cast<const uint8_t*>(str2.c_str());
-    size_t i = 0;
-    for (; i + 32 <= size; i += 32) {
-        uint8x16_t a0 = vld1q_u8(p1 + i);
-        uint8x16_t b0 = vld1q_u8(p2 + i);
-        uint8x16_t a1 = vld1q_u8(p1 + i + 16);
-        uint8x16_t b1 = vld1q_u8(p2 + i + 16);
-        uint8x16_t cmp0 = vceqq_u8(a0, b0);
-        uint8x16_t cmp1 = vceqq_u8(a1, b1);
-        uint64_t mask0 = vmaxvq_u8(cmp0);
-        uint64_t mask1 = vmaxvq_u8(cmp1);
-        if (mask0 != 255 || mask1 != 255) {
-            return false;
-        }
-    }
-
-    for (; i + 16 <= size; i += 16) {
-        uint8x16_t a = vld1q_u8(p1 + i);
-        uint8x16_t b = vld1q_u8(p2 + i);
-        uint8x16_t cmp = vceqq_u8(a, b);
-        uint64_t mask = vmaxvq_u8(cmp);
-        if (mask != 255) {
-            return false;
-        }
-    }
-    for (; i < size; ++i) {
-        if (p1[i] != p2[i]) {
-            return false;
-        }
+        return false;
     }
-    return true;
+    return neon_equal(cstr1, str2.c_str(), size);
 }
 
 //! POK  by Maksym Dzoban
@@ -1194,25 +3044,21 @@ my_str_simd& my_str_simd::operator+=(const char* mystr) {
     return *this;
 }
 
-//! POK by Maksym Dzoban
-//! SIMD не потр. бо оператор лише склеює дві великі операції разом
+//! АКС
+//! одна точна алокація замість копії mystr і дописування з перевиділенням
 my_str_simd operator+(const my_str_simd& mystr, const my_str_simd& mystr2) {
-    my_str_simd temp(mystr);
-    temp += mystr2;
-    return temp;
+    return my_str_simd::concat({mystr, mystr2});
 }
 
-//! POK by Maksym Dzoban
-//! SIMD не потр. бо оператор лише склеює дві великі операції разом
+//! АКС
+//! одна точна алокація замість копії mystr і дописування з перевиділенням
 my_str_simd operator+(const my_str_simd& mystr, const char* mystr2) {
-    my_str_simd temp(mystr);
-    temp += mystr2;
-    return temp;
+    return my_str_simd::concat({mystr, mystr2});
 }
 
 // by Maksym Dzoban
 my_str_simd operator+(const char* mystr, const my_str_simd& mystr2) {
-    return mystr2 + mystr;
+    return my_str_simd::concat({mystr, mystr2});
 }
 
 // by Maksym Dzoban
@@ -1224,43 +3070,94 @@ my_str_simd operator+(const my_str_simd& mystr, const char chr) {
 
 // by Lev Lysyk
 my_str_simd operator+(const char chr, const my_str_simd& mystr) {
-    return mystr + chr;
+    return my_str_simd::concat({my_str_simd_view(&chr, 1), mystr});
 }
 
-//! ПОК by Lev Lysyk
-//! reserve реалізований через SIMD
-//! append реалізований через SIMD
+//! АКС
+my_str_simd operator+(my_str_simd&& mystr, const my_str_simd& mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+//! АКС
+my_str_simd operator+(my_str_simd&& mystr, my_str_simd&& mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+//! АКС
+my_str_simd operator+(my_str_simd&& mystr, const char* mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+//! АКС
+my_str_simd operator+(my_str_simd&& mystr, const char chr) {
+    mystr.append(chr);
+    return std::move(mystr);
+}
+
+//! АКС
+my_str_simd operator+(const my_str_simd& mystr, my_str_simd&& mystr2) {
+    if (&mystr == &mystr2) {
+        return mystr + static_cast<const my_str_simd&>(mystr2);
+    }
+    mystr2.insert(0, mystr);
+    return std::move(mystr2);
+}
+
+//! АКС
+my_str_simd operator+(const char* mystr, my_str_simd&& mystr2) {
+    mystr2.insert(0, mystr);
+    return std::move(mystr2);
+}
+
+//! АКС
+my_str_simd operator+(const char chr, my_str_simd&& mystr2) {
+    mystr2.insert(0, chr);
+    return std::move(mystr2);
+}
+
+//! АКС
+//! Повторення подвоєнням: копіюємо вже побудований префікс сам на себе,
+//! тож потрібно лише log2(count) векторних копій і одна точна алокація.
+//! Для стрічки з однієї літери -- просто заповнення через vdupq_n_u8.
 my_str_simd& my_str_simd::operator*=(int const count) {
     if (count < 0)
     {
         throw(std::invalid_argument("my_str_t::operator*=(int const count)"));
     }
-    reserve(2 * (size_m * count) + 1);
-    my_str_simd const str_copy(*this);
-    for(int i = 1; i < count; ++i)
-    {
-        append(str_copy);
+    size_t const unit = size_m;
+    size_t const new_size = unit * count;
+    reserve(new_size + 1);
+    if (unit == 1 && new_size > 1) {
+        neon_memset(data_m + 1, data_m[0], new_size - 1);
+    } else {
+        size_t filled = (new_size < unit) ? new_size : unit;
+        while (filled < new_size) {
+            size_t const chunk = (filled < new_size - filled) ? filled : new_size - filled;
+            neon_memcpy(data_m, data_m + filled, chunk);
+            filled += chunk;
+        }
     }
-    size_m = str_copy.size_m * count;
+    size_m = new_size;
     data_m[size_m] = '\0';
     return *this;
 };
 
-//! ПОК by Lev Lysyk
-//! reserve реалізований через SIMD
-//! append реалізований через SIMD
+//! АКС
+//! одна алокація точного розміру, далі подвоєння через *=
 my_str_simd operator*(const my_str_simd& str1, int const count) {
     if (count < 0)
     {
         throw(std::invalid_argument("my_str_t::operator*=(int const count)"));
     }
-    my_str_simd result(str1);
-    result.reserve(2 * (result.size() * count) + 1);
-    for (int i = 1; i < count; ++i)
-    {
+    my_str_simd result;
+    if (count > 0) {
+        result.reserve(str1.size() * count + 1);
         result.append(str1);
+        result *= count;
     }
-    result.resize(str1.size() * count);
     return result;
 }
 
@@ -1295,4 +3192,479 @@ my_str_simd& my_str_simd::operator=(my_str_simd&& other_str) noexcept {
     other_str.capacity_m = 0;
     return *this;
 }
+
+//! АКС
+my_str_simd_view::my_str_simd_view() noexcept : data_m(""), size_m(0) {}
+
+my_str_simd_view::my_str_simd_view(const char* data, size_t size) noexcept
+: data_m(data), size_m(size) {}
+
+my_str_simd_view::my_str_simd_view(const char* cstr) {
+    if (cstr == nullptr) {
+        throw std::logic_error("Null pointer passed to constructor");
+    }
+    data_m = cstr;
+    size_m = std::strlen(cstr);
+}
+
+my_str_simd_view::my_str_simd_view(const my_str_simd& str) noexcept
+: data_m(str.c_str()), size_m(str.size()) {}
+
+const char& my_str_simd_view::operator[](size_t idx) const {
+    if (idx >= size_m) {
+        throw std::out_of_range("Incorrect index!");
+    }
+    return data_m[idx];
+}
+
+const char& my_str_simd_view::at(size_t idx) const {
+    if (idx >= size_m) {
+        throw std::out_of_range("Incorrect index!");
+    }
+    return data_m[idx];
+}
+
+my_str_simd_view my_str_simd_view::substr(size_t begin, size_t size) const {
+    if (begin > size_m) {
+        throw std::out_of_range("Incorrect index!");
+    }
+    return {data_m + begin, (size > size_m - begin) ? size_m - begin : size};
+}
+
+size_t my_str_simd_view::find(char c, size_t idx) const {
+    if (idx > size_m) {
+        throw std::out_of_range("my_str_simd_view::find");
+    }
+    size_t const pos = neon_find_char(data_m + idx, size_m - idx, c);
+    return (pos == size_m - idx) ? not_found : idx + pos;
+}
+
+size_t my_str_simd_view::find(my_str_simd_view str, size_t idx) const {
+    if (idx > size_m) {
+        throw std::out_of_range("my_str_simd_view::find");
+    }
+    return neon_find_str(data_m, size_m, str.data_m, str.size_m, idx);
+}
+
+size_t my_str_simd_view::find(const std::string& str, size_t idx) const {
+    return find(my_str_simd_view(str.data(), str.size()), idx);
+}
+
+size_t my_str_simd_view::find(const char* cstr, size_t idx) const {
+    return find(my_str_simd_view(cstr), idx);
+}
+
+void my_str_simd_view::split(char delim, std::vector<my_str_simd_view>& out) const {
+    uint8x16_t const target = vdupq_n_u8(static_cast<uint8_t>(delim));
+    neon_split(data_m, size_m,
+        [target](const char* block) {
+            return neon_movemask(vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(block)), target));
+        },
+        [delim](char c) { return c == delim; }, out);
+}
+
+void my_str_simd_view::split_any(my_str_simd_view charset, std::vector<my_str_simd_view>& out) const {
+    bool is_delim[256] = {};
+    for (size_t i = 0; i < charset.size_m; ++i) {
+        is_delim[static_cast<unsigned char>(charset.data_m[i])] = true;
+    }
+    auto delim_char = [&is_delim](char c) { return is_delim[static_cast<unsigned char>(c)]; };
+    if (charset.size_m > split_set_limit) {
+        neon_split(data_m, size_m,
+            [&delim_char](const char* block) {
+                uint64_t mask = 0;
+                for (size_t i = 0; i < 16; ++i) {
+                    mask |= uint64_t(delim_char(block[i])) << (4 * i + 3);
+                }
+                return mask;
+            },
+            delim_char, out);
+        return;
+    }
+    uint8x16_t targets[split_set_limit];
+    size_t const count = charset.size_m;
+    for (size_t i = 0; i < count; ++i) {
+        targets[i] = vdupq_n_u8(static_cast<uint8_t>(charset.data_m[i]));
+    }
+    neon_split(data_m, size_m,
+        [&targets, count](const char* block) {
+            uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+            uint8x16_t hits = vdupq_n_u8(0);
+            for (size_t i = 0; i < count; ++i) {
+                hits = vorrq_u8(hits, vceqq_u8(data, targets[i]));
+            }
+            return neon_movemask(hits);
+        },
+        delim_char, out);
+}
+
+my_str_simd_view my_str_simd_view::ltrim() const {
+    size_t const begin = neon_find_space(data_m, size_m, false);
+    return {data_m + begin, size_m - begin};
+}
+
+my_str_simd_view my_str_simd_view::rtrim() const {
+    return {data_m, neon_rfind_nonspace(data_m, size_m)};
+}
+
+my_str_simd_view my_str_simd_view::trim() const {
+    return ltrim().rtrim();
+}
+
+bool my_str_simd_view::is_valid_utf8() const {
+    return neon_is_valid_utf8(data_m, size_m);
+}
+
+size_t my_str_simd_view::utf8_length() const {
+    return neon_utf8_length(data_m, size_m);
+}
+
+size_t my_str_simd_view::utf8_offset(size_t n) const {
+    size_t const offset = neon_utf8_offset(data_m, size_m, n);
+    if (offset == not_found) {
+        throw std::out_of_range("my_str_simd_view::utf8_offset");
+    }
+    return offset;
+}
+
+std::u16string my_str_simd_view::to_utf16() const {
+    std::u16string out;
+    if (neon_utf8_to_utf16(data_m, size_m, out) != not_found) {
+        throw std::invalid_argument("my_str_simd_view::to_utf16");
+    }
+    return out;
+}
+
+std::u32string my_str_simd_view::to_utf32() const {
+    std::u32string out;
+    if (neon_utf8_to_utf32(data_m, size_m, out) != not_found) {
+        throw std::invalid_argument("my_str_simd_view::to_utf32");
+    }
+    return out;
+}
+
+size_t my_str_simd_view::to_utf16(std::u16string& out) const {
+    return neon_utf8_to_utf16(data_m, size_m, out);
+}
+
+size_t my_str_simd_view::to_utf32(std::u32string& out) const {
+    return neon_utf8_to_utf32(data_m, size_m, out);
+}
+
+my_str_simd_url my_str_simd_view::parse_url() const {
+    my_str_simd_url url;
+    size_t pos = 0;
+    size_t const first = neon_find_any_of(data_m, size_m, ":/?#");
+    if (first < size_m && first > 0 && data_m[first] == ':') {
+        url.scheme = {data_m, first};
+        pos = first + 1;
+    }
+    if (size_m - pos >= 2 && data_m[pos] == '/' && data_m[pos + 1] == '/') {
+        pos += 2;
+        size_t const end = pos + neon_find_any_of(data_m + pos, size_m - pos, "/?#");
+        size_t host_begin = pos;
+        for (size_t i = end; i > pos; --i) {
+            if (data_m[i - 1] == '@') {
+                url.userinfo = {data_m + pos, i - 1 - pos};
+                host_begin = i;
+                break;
+            }
+        }
+        size_t host_end = end;
+        for (size_t i = end; i > host_begin && data_m[i - 1] != ']'; --i) {
+            if (data_m[i - 1] == ':') {
+                url.port = {data_m + i, end - i};
+                host_end = i - 1;
+                break;
+            }
+        }
+        url.host = {data_m + host_begin, host_end - host_begin};
+        pos = end;
+    }
+    size_t const path_end = pos + neon_find_any_of(data_m + pos, size_m - pos, "?#");
+    url.path = {data_m + pos, path_end - pos};
+    pos = path_end;
+    if (pos < size_m && data_m[pos] == '?') {
+        size_t const query_end = pos + 1 + neon_find_char(data_m + pos + 1, size_m - pos - 1, '#');
+        url.query = {data_m + pos + 1, query_end - pos - 1};
+        pos = query_end;
+    }
+    if (pos < size_m) {
+        url.fragment = {data_m + pos + 1, size_m - pos - 1};
+    }
+    return url;
+}
+
+int64_t my_str_simd_view::to_int64() const {
+    bool const negative = size_m > 0 && data_m[0] == '-';
+    size_t const sign = (size_m > 0 && (data_m[0] == '-' || data_m[0] == '+')) ? 1 : 0;
+    uint64_t magnitude = 0;
+    bool overflow = false;
+    if (size_m == sign || !neon_parse_uint(data_m + sign, size_m - sign, magnitude, overflow)) {
+        throw std::invalid_argument("my_str_simd_view::to_int64");
+    }
+    uint64_t const limit = negative ? uint64_t(INT64_MAX) + 1 : uint64_t(INT64_MAX);
+    if (overflow || magnitude > limit) {
+        throw std::out_of_range("my_str_simd_view::to_int64");
+    }
+    return negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+}
+
+uint64_t my_str_simd_view::to_uint64() const {
+    size_t const sign = (size_m > 0 && data_m[0] == '+') ? 1 : 0;
+    uint64_t value = 0;
+    bool overflow = false;
+    if (size_m == sign || !neon_parse_uint(data_m + sign, size_m - sign, value, overflow)) {
+        throw std::invalid_argument("my_str_simd_view::to_uint64");
+    }
+    if (overflow) {
+        throw std::out_of_range("my_str_simd_view::to_uint64");
+    }
+    return value;
+}
+
+double my_str_simd_view::to_double() const {
+    double value = 0;
+    if (parse_double_fast(data_m, size_m, neon_parse_uint, value)) {
+        return value;
+    }
+    const char* begin = data_m;
+    const char* const end = data_m + size_m;
+    if (begin != end && *begin == '+' && end - begin > 1 && begin[1] != '-') {
+        ++begin;
+    }
+    std::from_chars_result const result = std::from_chars(begin, end, value);
+    if (result.ec == std::errc::invalid_argument || result.ptr != end) {
+        throw std::invalid_argument("my_str_simd_view::to_double");
+    }
+    if (result.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range("my_str_simd_view::to_double");
+    }
+    return value;
+}
+
+void my_str_simd_view::json_index(std::vector<size_t>& out) const {
+    if (!neon_json_index(data_m, size_m, out)) {
+        throw std::invalid_argument("my_str_simd_view::json_index: unterminated string");
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, my_str_simd_view view) {
+    stream.write(view.data(), static_cast<std::streamsize>(view.size()));
+    return stream;
+}
+
+bool operator==(my_str_simd_view view1, my_str_simd_view view2) {
+    return view1.size() == view2.size() && neon_equal(view1.data(), view2.data(), view1.size());
+}
+
+bool operator!=(my_str_simd_view view1, my_str_simd_view view2) {
+    return !(view1 == view2);
+}
+
+//! той самий порядок, що й у my_str_simd: спершу за довжиною, тоді за першою
+//! відмінною літерою, яку шукає SIMD-порівняння
+bool operator<(my_str_simd_view view1, my_str_simd_view view2) {
+    if (view1.size() != view2.size()) {
+        return view1.size() < view2.size();
+    }
+    size_t const pos = neon_mismatch(view1.data(), view2.data(), view1.size());
+    return pos < view1.size() && view1.data()[pos] < view2.data()[pos];
+}
+
+bool operator>(my_str_simd_view view1, my_str_simd_view view2) {
+    return view2 < view1;
+}
+
+bool operator<=(my_str_simd_view view1, my_str_simd_view view2) {
+    return !(view2 < view1);
+}
+
+bool operator>=(my_str_simd_view view1, my_str_simd_view view2) {
+    return !(view1 < view2);
+}
+
+//! АКС
+my_str_simd_lines::iterator::iterator(const char* data, size_t size, size_t pos)
+: data_m(data), size_m(size), pos_m(pos), next_m(pos), block_m(pos), mask_m(0) {
+    if (pos_m < size_m) {
+        mask_m = neon_newline_mask(data_m, size_m, block_m);
+        load_line();
+    }
+}
+
+//! наступний '\n' після вже знайдених, або size_m
+size_t my_str_simd_lines::iterator::next_newline() {
+    while (mask_m == 0) {
+        block_m += line_block;
+        if (block_m >= size_m) {
+            return size_m;
+        }
+        mask_m = neon_newline_mask(data_m, size_m, block_m);
+    }
+    size_t const pos = block_m + (__builtin_ctzll(mask_m) >> 2);
+    mask_m &= mask_m - 1;
+    return pos;
+}
+
+void my_str_simd_lines::iterator::load_line() {
+    size_t const newline = next_newline();
+    size_t end = newline;
+    if (newline < size_m) {
+        next_m = newline + 1;
+        if (end > pos_m && data_m[end - 1] == '\r') {
+            --end;
+        }
+    } else {
+        next_m = size_m;
+    }
+    line_m = my_str_simd_view(data_m + pos_m, end - pos_m);
+}
+
+my_str_simd_lines::iterator& my_str_simd_lines::iterator::operator++() {
+    pos_m = next_m;
+    if (pos_m < size_m) {
+        load_line();
+    }
+    return *this;
+}
+
+my_str_simd_lines::iterator my_str_simd_lines::iterator::operator++(int) {
+    iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+my_str_simd_lines::iterator my_str_simd_lines::begin() const {
+    return iterator(text_m.data(), text_m.size(), 0);
+}
+
+my_str_simd_lines::iterator my_str_simd_lines::end() const {
+    return iterator(text_m.data(), text_m.size(), text_m.size());
+}
+
+my_str_simd_csv::iterator::iterator(const char* data, size_t size, char delimiter, size_t pos)
+: data_m(data), size_m(size), delimiter_m(delimiter), pos_m(pos), next_m(pos), block_m(pos), mask_m(0), in_quotes_m(0) {
+    if (pos_m < size_m) {
+        load_block();
+        load_row();
+    }
+}
+
+//! роздільники блоку block_m поза лапками; стан лапок переноситься на наступний блок
+void my_str_simd_csv::iterator::load_block() {
+    uint64_t quote = 0;
+    uint64_t separator = 0;
+    neon_csv_masks(data_m, size_m, block_m, delimiter_m, quote, separator);
+    uint64_t const in_quotes = prefix_xor(quote) ^ in_quotes_m;
+    in_quotes_m = static_cast<uint64_t>(static_cast<int64_t>(in_quotes) >> 63);
+    mask_m = separator & ~in_quotes;
+}
+
+//! наступний роздільник поля чи запису після вже знайдених, або size_m
+size_t my_str_simd_csv::iterator::next_separator() {
+    while (mask_m == 0) {
+        block_m += 64;
+        if (block_m >= size_m) {
+            return size_m;
+        }
+        load_block();
+    }
+    size_t const pos = block_m + __builtin_ctzll(mask_m);
+    mask_m &= mask_m - 1;
+    return pos;
+}
+
+void my_str_simd_csv::iterator::load_row() {
+    fields_m.clear();
+    size_t start = pos_m;
+    for (;;) {
+        size_t const separator = next_separator();
+        bool const last = separator == size_m || data_m[separator] == '\n';
+        size_t end = separator;
+        if (last && end > start && data_m[end - 1] == '\r') {
+            --end;
+        }
+        if (end - start >= 2 && data_m[start] == '"' && data_m[end - 1] == '"') {
+            fields_m.emplace_back(data_m + start + 1, end - start - 2);
+        } else {
+            fields_m.emplace_back(data_m + start, end - start);
+        }
+        if (last) {
+            next_m = separator < size_m ? separator + 1 : size_m;
+            return;
+        }
+        start = separator + 1;
+    }
+}
+
+my_str_simd_csv::iterator& my_str_simd_csv::iterator::operator++() {
+    pos_m = next_m;
+    if (pos_m < size_m) {
+        load_row();
+    }
+    return *this;
+}
+
+my_str_simd_csv::iterator my_str_simd_csv::iterator::operator++(int) {
+    iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+my_str_simd_csv::iterator my_str_simd_csv::begin() const {
+    return iterator(text_m.data(), text_m.size(), delimiter_m, 0);
+}
+
+my_str_simd_csv::iterator my_str_simd_csv::end() const {
+    return iterator(text_m.data(), text_m.size(), delimiter_m, text_m.size());
+}
+
+//! АКС
+my_str_simd_code_points::iterator::iterator(const char* data, size_t size, size_t pos)
+: data_m(data), size_m(size), pos_m(pos), next_m(pos), code_point_m(0) {
+    if (pos_m < size_m) {
+        decode();
+    }
+}
+
+//! декодує код з pos_m; неправильний чи обірваний -- U+FFFD довжиною в байт
+void my_str_simd_code_points::iterator::decode() {
+    char32_t code_point = 0;
+    size_t const length = utf8_decode(data_m + pos_m, size_m - pos_m, code_point);
+    if (length == 0) {
+        code_point_m = 0xFFFD;
+        next_m = pos_m + 1;
+        return;
+    }
+    code_point_m = code_point;
+    next_m = pos_m + length;
+}
+
+//! АКС
+my_str_simd_code_points::iterator& my_str_simd_code_points::iterator::operator++() {
+    pos_m = next_m;
+    if (pos_m < size_m) {
+        decode();
+    }
+    return *this;
+}
+
+//! АКС
+my_str_simd_code_points::iterator my_str_simd_code_points::iterator::operator++(int) {
+    iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+//! АКС
+my_str_simd_code_points::iterator my_str_simd_code_points::begin() const {
+    return iterator(text_m.data(), text_m.size(), 0);
+}
+
+//! АКС
+my_str_simd_code_points::iterator my_str_simd_code_points::end() const {
+    return iterator(text_m.data(), text_m.size(), text_m.size());
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "mapped_file.h"
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int to_madvise(mapped_file::access hint) {
+    switch (hint) {
+        case mapped_file::access::sequential: return MADV_SEQUENTIAL;
+        case mapped_file::access::random: return MADV_RANDOM;
+        default: return MADV_NORMAL;
+    }
+}
+
+mapped_file::mapped_file(const char* path, access hint)
+: data_m(""), size_m(0) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        int const error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), path);
+    }
+    size_t const size = static_cast<size_t>(info.st_size);
+    if (size == 0) {
+        // mmap не відображає порожні файли -- лишаємо порожній view
+        ::close(fd);
+        return;
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int const error = errno;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), path);
+    }
+    data_m = static_cast<const char*>(mapping);
+    size_m = size;
+    advise(hint);
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+: data_m(other.data_m), size_m(other.size_m) {
+    other.data_m = "";
+    other.size_m = 0;
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (size_m != 0) {
+        ::munmap(const_cast<char*>(data_m), size_m);
+    }
+    data_m = other.data_m;
+    size_m = other.size_m;
+    other.data_m = "";
+    other.size_m = 0;
+    return *this;
+}
+
+mapped_file::~mapped_file() {
+    if (size_m != 0) {
+        ::munmap(const_cast<char*>(data_m), size_m);
+    }
+}
+
+void mapped_file::advise(access hint) const {
+    if (size_m != 0) {
+        ::madvise(const_cast<char*>(data_m), size_m, to_madvise(hint));
+    }
+}
+
+void mapped_file::prefetch(size_t offset, size_t size) const {
+    if (offset >= size_m || size == 0) {
+        return;
+    }
+    if (size > size_m - offset) {
+        size = size_m - offset;
+    }
+    // madvise вимагає вирівнювання початку на сторінку
+    size_t const page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t const aligned = offset - offset % page;
+    ::madvise(const_cast<char*>(data_m) + aligned, size + (offset - aligned), MADV_WILLNEED);
+}
@@ -0,0 +1,44 @@
+#ifndef mapped_file_h
+#define mapped_file_h
+#pragma once
+
+#include <cstddef>
+
+//! Файл, відображений у пам'ять лише для читання (mmap). Дані не копіюються:
+//! їх можна одразу переглядати через view будь-якої з реалізацій, напр.
+//!     mapped_file file("log.txt");
+//!     my_str_avx_view text = file.view<my_str_avx_view>();
+//! view лишаються дійсними, поки живий mapped_file.
+class mapped_file {
+public:
+    //! Підказки ядру щодо порядку доступу (madvise)
+    enum class access { normal, sequential, random };
+
+private:
+    const char* data_m;
+    size_t size_m;
+
+public:
+    //! Обробка помилок: якщо файл не вдалося відкрити чи відобразити --
+    //! кидає std::system_error з кодом errno.
+    explicit mapped_file(const char* path, access hint = access::sequential);
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+    ~mapped_file();
+
+    const char* data() const { return data_m; }
+    size_t size() const { return size_m; }
+
+    template <typename View>
+    View view() const { return View(data_m, size_m); }
+
+    //! Змінює підказку щодо порядку доступу для всього файлу
+    void advise(access hint) const;
+    //! Просить ядро наперед підвантажити [offset, offset + size) (MADV_WILLNEED)
+    void prefetch(size_t offset, size_t size) const;
+};
+
+#endif
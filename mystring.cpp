@@ -3,6 +3,7 @@
 #include <iostream>
 #include "mystring.hpp"
 #include <cstring>
+#include <utility>
 
 // by Lev Lysyk
 //! допоміжний конструктор
@@ -515,7 +516,9 @@ my_str_t operator+(const my_str_t& mystr, const char* mystr2) {
 
 // by Maksym Dzoban
 my_str_t operator+(const char* mystr, const my_str_t& mystr2) {
-    return mystr2 + mystr;
+    my_str_t temp(mystr);
+    temp += mystr2;
+    return temp;
 }
 
 // by Maksym Dzoban
@@ -527,7 +530,47 @@ my_str_t operator+(const my_str_t& mystr, const char chr) {
 
 // by Lev Lysyk
 my_str_t operator+(const char chr, const my_str_t& mystr) {
-    return mystr + chr;
+    my_str_t temp(1, chr);
+    temp += mystr;
+    return temp;
+}
+
+my_str_t operator+(my_str_t&& mystr, const my_str_t& mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+my_str_t operator+(my_str_t&& mystr, my_str_t&& mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+my_str_t operator+(my_str_t&& mystr, const char* mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+my_str_t operator+(my_str_t&& mystr, const char chr) {
+    mystr.append(chr);
+    return std::move(mystr);
+}
+
+my_str_t operator+(const my_str_t& mystr, my_str_t&& mystr2) {
+    if (&mystr == &mystr2) {
+        return mystr + static_cast<const my_str_t&>(mystr2);
+    }
+    mystr2.insert(0, mystr);
+    return std::move(mystr2);
+}
+
+my_str_t operator+(const char* mystr, my_str_t&& mystr2) {
+    mystr2.insert(0, mystr);
+    return std::move(mystr2);
+}
+
+my_str_t operator+(const char chr, my_str_t&& mystr2) {
+    mystr2.insert(0, chr);
+    return std::move(mystr2);
 }
 
 // by Lev Lysyk
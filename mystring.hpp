@@ -115,9 +115,20 @@ bool operator<=(const my_str_t& str1, const char* cstr2);
 
 my_str_t operator+(const my_str_t& mystr, const my_str_t& mystr2);
 my_str_t operator+(const my_str_t& mystr, const char* mystr2);
+my_str_t operator+(const char* mystr, const my_str_t& mystr2);
 my_str_t operator+(const my_str_t& mystr2, char chr);
 my_str_t operator+(char chr, const my_str_t& mystr2);
 
+//! Тимчасовий операнд віддає свій буфер результату: лівий дописується,
+//! у правий вставляється початок, тож std::move(a) + b не копіює a.
+my_str_t operator+(my_str_t&& mystr, const my_str_t& mystr2);
+my_str_t operator+(my_str_t&& mystr, my_str_t&& mystr2);
+my_str_t operator+(my_str_t&& mystr, const char* mystr2);
+my_str_t operator+(my_str_t&& mystr, char chr);
+my_str_t operator+(const my_str_t& mystr, my_str_t&& mystr2);
+my_str_t operator+(const char* mystr, my_str_t&& mystr2);
+my_str_t operator+(char chr, my_str_t&& mystr2);
+
 my_str_t operator*(const my_str_t& str1, int count);
 my_str_t operator*(int count, const my_str_t& str1);
 
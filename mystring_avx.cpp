@@ -4,6 +4,12 @@
 #include "mystring_avx.h"
 #include <iostream>
 #include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <streambuf>
+#include <vector>
+#include <functional>
+#include <charconv>
 
 inline void avx2_memcpy(const char* src, char* dst, size_t size) {
     size_t i = 0;
@@ -16,6 +22,1491 @@ inline void avx2_memcpy(const char* src, char* dst, size_t size) {
     }
 }
 
+inline void avx2_memset(char* dst, char c, size_t size) {
+    __m256i fill = _mm256_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), fill);
+    }
+    for (; i < size; ++i) {
+        dst[i] = c;
+    }
+}
+
+//! Позиція першої літери c у [src, src + size), або size, якщо її немає.
+inline size_t avx2_find_char(const char* src, size_t size, char c) {
+    __m256i target = _mm256_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, target));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < size; ++i) {
+        if (src[i] == c) {
+            return i;
+        }
+    }
+    return size;
+}
+
+//! Позиція першого входження needle довжини len у [src + idx, src + size),
+//! або my_str_avx::not_found. Кандидатів відсіює SIMD-порівняння першої та
+//! останньої літери needle, повністю порівнюються лише ті, де збіглися обидві.
+inline size_t avx2_find_str(const char* src, size_t size, const char* needle, size_t len, size_t idx) {
+    if (len == 0) {
+        return idx;
+    }
+    if (len > size - idx) {
+        return my_str_avx::not_found;
+    }
+    __m256i first = _mm256_set1_epi8(needle[0]);
+    __m256i last = _mm256_set1_epi8(needle[len - 1]);
+    size_t i = idx;
+    for (; i + len - 1 + 32 <= size; i += 32) {
+        __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + len - 1));
+        __m256i cmp = _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first),
+                                       _mm256_cmpeq_epi8(block_last, last));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(cmp));
+        while (mask != 0) {
+            size_t const candidate = i + __builtin_ctz(mask);
+            if (std::memcmp(src + candidate + 1, needle + 1, len - 1) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    for (; i + len <= size; ++i) {
+        if (src[i] == needle[0] && std::memcmp(src + i, needle, len) == 0) {
+            return i;
+        }
+    }
+    return my_str_avx::not_found;
+}
+
+//! Позиція першого байта, в якому a і b різняться, або size.
+inline size_t avx2_mismatch(const char* a, const char* b, size_t size) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < size; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+inline bool avx2_equal(const char* a, const char* b, size_t size) {
+    return avx2_mismatch(a, b, size) == size;
+}
+
+//! ASCII-пробіли як у std::isspace для "C" локалі: ' ', '\t', '\n', '\v', '\f', '\r'
+inline bool is_ascii_space(char c) {
+    return c == ' ' || static_cast<unsigned>(static_cast<unsigned char>(c) - '\t') <= 4u;
+}
+
+//! 0xFF у байтах-пробілах блоку. '\t'..'\r' ідуть підряд, тож це одне
+//! беззнакове порівняння (c - '\t') <= 4.
+inline __m256i avx2_space_bytes(__m256i block) {
+    __m256i is_blank = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(' '));
+    __m256i shifted = _mm256_sub_epi8(block, _mm256_set1_epi8('\t'));
+    __m256i is_ctrl = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted);
+    return _mm256_or_si256(is_blank, is_ctrl);
+}
+
+//! Біт i маски встановлений, якщо байт i блоку -- пробільна літера.
+inline unsigned avx2_space_mask(__m256i block) {
+    return static_cast<unsigned>(_mm256_movemask_epi8(avx2_space_bytes(block)));
+}
+
+//! Позиція першої пробільної (want_space) чи непробільної літери, або size.
+inline size_t avx2_find_space(const char* src, size_t size, bool want_space = true) {
+    unsigned const flip = want_space ? 0u : 0xFFFFFFFFu;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        unsigned mask = avx2_space_mask(block) ^ flip;
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < size; ++i) {
+        if (is_ascii_space(src[i]) == want_space) {
+            return i;
+        }
+    }
+    return size;
+}
+
+//! Кінець тексту без пробілів у хвості: позиція за останньою непробільною
+//! літерою, або 0. Блоки йдуть від кінця, старший біт маски -- остання така літера.
+inline size_t avx2_rfind_nonspace(const char* src, size_t size) {
+    size_t i = size;
+    for (; i >= 32; i -= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i - 32));
+        unsigned mask = ~avx2_space_mask(block);
+        if (mask != 0) {
+            return i - __builtin_clz(mask);
+        }
+    }
+    for (; i > 0; --i) {
+        if (!is_ascii_space(src[i - 1])) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+//! Розмір блоку, яким my_str_avx_lines шукає кінці рядків.
+constexpr size_t line_block = 32;
+
+//! Маска '\n' у байтах [block, block + 32) тексту; хвіст коротший за блок
+//! перевіряється посимвольно.
+inline uint64_t avx2_newline_mask(const char* src, size_t size, size_t block) {
+    if (block + 32 <= size) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + block));
+        __m256i cmp = _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\n'));
+        return static_cast<uint32_t>(_mm256_movemask_epi8(cmp));
+    }
+    uint64_t mask = 0;
+    for (size_t i = block; i < size; ++i) {
+        if (src[i] == '\n') {
+            mask |= uint64_t(1) << (i - block);
+        }
+    }
+    return mask;
+}
+
+//! Найбільший charset, для якого split_any порівнює блок з кожною літерою
+//! окремо; для довших наборів маску блоку рахує таблиця посимвольно.
+constexpr size_t split_set_limit = 16;
+
+//! Ділить [src, src + size) на поля між роздільниками і дописує їх в out.
+//! block_mask(ptr) дає маску роздільників у 32 байтах від ptr, is_delim
+//! перевіряє хвіст. Маска обходиться побітово, тож на поле -- одна
+//! ctz-операція замість окремого find.
+template <typename BlockMask, typename IsDelim>
+inline void avx2_split(const char* src, size_t size, BlockMask block_mask, IsDelim is_delim,
+                       std::vector<my_str_avx_view>& out) {
+    out.clear();
+    size_t start = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        uint32_t mask = block_mask(src + i);
+        while (mask != 0) {
+            size_t const pos = i + __builtin_ctz(mask);
+            out.emplace_back(src + start, pos - start);
+            start = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    for (; i < size; ++i) {
+        if (is_delim(src[i])) {
+            out.emplace_back(src + start, i - start);
+            start = i + 1;
+        }
+    }
+    out.emplace_back(src + start, size - start);
+}
+
+//! Копіює size байт з src у dst (можуть збігатися), міняючи регістр ASCII-літер
+//! з [first, last]: у них відрізняється лише біт 0x20. Діапазон перевіряють два
+//! знакові порівняння -- байти >= 0x80 від'ємні й не потрапляють у нього.
+inline void avx2_flip_case(const char* src, char* dst, size_t size, char first, char last) {
+    __m256i const below = _mm256_set1_epi8(static_cast<char>(first - 1));
+    __m256i const above = _mm256_set1_epi8(static_cast<char>(last + 1));
+    __m256i const bit = _mm256_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(data, below), _mm256_cmpgt_epi8(above, data));
+        data = _mm256_xor_si256(data, _mm256_and_si256(in_range, bit));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), data);
+    }
+    for (; i < size; ++i) {
+        char const c = src[i];
+        dst[i] = (c >= first && c <= last) ? static_cast<char>(c ^ 0x20) : c;
+    }
+}
+
+//! Найбільша кількість змінених байтів таблиці, для якої translate порівнює
+//! блок з кожним із них і підставляє заміну blend-ом; для більших таблиць
+//! перекодування йде повним пошуком у 256 записах.
+constexpr size_t translate_blend_limit = 8;
+
+//! Заміна кожного байта data на table[byte]. Загальний шлях -- 16 pshufb:
+//! рядок h таблиці (записи h * 16 .. h * 16 + 15) індексується молодшою
+//! тетрадою, а старша тетрада вибирає, чий результат залишити.
+inline void avx2_translate(char* data, size_t size, const uint8_t* table) {
+    uint8_t from[translate_blend_limit];
+    uint8_t to[translate_blend_limit];
+    size_t changed = 0;
+    for (size_t c = 0; c < 256 && changed <= translate_blend_limit; ++c) {
+        if (table[c] != c) {
+            if (changed < translate_blend_limit) {
+                from[changed] = static_cast<uint8_t>(c);
+                to[changed] = table[c];
+            }
+            ++changed;
+        }
+    }
+    if (changed == 0) {
+        return;
+    }
+    size_t i = 0;
+    if (changed <= translate_blend_limit) {
+        for (; i + 32 <= size; i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i result = block;
+            for (size_t k = 0; k < changed; ++k) {
+                __m256i hit = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(from[k])));
+                result = _mm256_blendv_epi8(result, _mm256_set1_epi8(static_cast<char>(to[k])), hit);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), result);
+        }
+    } else {
+        __m256i rows[16];
+        for (size_t h = 0; h < 16; ++h) {
+            rows[h] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * h)));
+        }
+        __m256i const low_bits = _mm256_set1_epi8(0x0F);
+        for (; i + 32 <= size; i += 32) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i low = _mm256_and_si256(block, low_bits);
+            __m256i high = _mm256_and_si256(_mm256_srli_epi16(block, 4), low_bits);
+            __m256i result = _mm256_setzero_si256();
+            for (size_t h = 0; h < 16; ++h) {
+                __m256i row_hit = _mm256_cmpeq_epi8(high, _mm256_set1_epi8(static_cast<char>(h)));
+                result = _mm256_or_si256(result, _mm256_and_si256(row_hit, _mm256_shuffle_epi8(rows[h], low)));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), result);
+        }
+    }
+    for (; i < size; ++i) {
+        data[i] = static_cast<char>(table[static_cast<unsigned char>(data[i])]);
+    }
+}
+
+//! Перевірка UTF-8 за алгоритмом Keiser-Lemire ("lookup"): кожна пара
+//! сусідніх байтів класифікується трьома таблицями по 16 записів -- за старшою
+//! і молодшою тетрадою попереднього байта та старшою тетрадою поточного.
+//! Біти записів -- види помилок; AND трьох результатів ненульовий лише для
+//! неправильних пар. Третій і четвертий байти послідовностей перевіряються
+//! окремо порівнянням з байтами за 2 і 3 позиції раніше.
+constexpr uint8_t utf8_too_short = 1 << 0;
+constexpr uint8_t utf8_too_long = 1 << 1;
+constexpr uint8_t utf8_overlong_3 = 1 << 2;
+constexpr uint8_t utf8_too_large = 1 << 3;
+constexpr uint8_t utf8_surrogate = 1 << 4;
+constexpr uint8_t utf8_overlong_2 = 1 << 5;
+constexpr uint8_t utf8_too_large_1000 = 1 << 6;
+constexpr uint8_t utf8_overlong_4 = 1 << 6;
+constexpr uint8_t utf8_two_conts = 1 << 7;
+constexpr uint8_t utf8_carry = utf8_too_short | utf8_too_long | utf8_two_conts;
+
+alignas(16) constexpr uint8_t utf8_byte_1_high[16] = {
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    utf8_two_conts, utf8_two_conts, utf8_two_conts, utf8_two_conts,
+    utf8_too_short | utf8_overlong_2,
+    utf8_too_short,
+    utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+    utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4,
+};
+
+alignas(16) constexpr uint8_t utf8_byte_1_low[16] = {
+    utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4,
+    utf8_carry | utf8_overlong_2,
+    utf8_carry,
+    utf8_carry,
+    utf8_carry | utf8_too_large,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+};
+
+alignas(16) constexpr uint8_t utf8_byte_2_high[16] = {
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large_1000 | utf8_overlong_4,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+};
+
+//! Найбільші байти, після яких блок може закінчитись: у трьох останніх
+//! позиціях не може стояти початок послідовності, довшої за решту блоку.
+alignas(32) constexpr uint8_t utf8_incomplete_max[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+
+//! Чи є [src, src + size) коректним UTF-8. По 64 байти за крок: якщо обидва
+//! блоки ASCII, перевіряється лише, що попередній блок не обірвав послідовність.
+inline bool avx2_is_valid_utf8(const char* src, size_t size) {
+    __m256i const byte_1_high = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_high)));
+    __m256i const byte_1_low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_low)));
+    __m256i const byte_2_high = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(utf8_byte_2_high)));
+    __m256i const incomplete_max = _mm256_load_si256(reinterpret_cast<const __m256i*>(utf8_incomplete_max));
+    __m256i const low_bits = _mm256_set1_epi8(0x0F);
+    __m256i prev = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    __m256i error = _mm256_setzero_si256();
+    auto check_block = [&](__m256i block) {
+        __m256i shifted = _mm256_permute2x128_si256(prev, block, 0x21);
+        __m256i prev1 = _mm256_alignr_epi8(block, shifted, 15);
+        __m256i prev2 = _mm256_alignr_epi8(block, shifted, 14);
+        __m256i prev3 = _mm256_alignr_epi8(block, shifted, 13);
+        __m256i special = _mm256_and_si256(
+            _mm256_and_si256(
+                _mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_bits)),
+                _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, low_bits))),
+            _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_bits)));
+        __m256i must_continue = _mm256_or_si256(
+            _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80))),
+            _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+        must_continue = _mm256_and_si256(must_continue, _mm256_set1_epi8(static_cast<char>(0x80)));
+        error = _mm256_or_si256(error, _mm256_xor_si256(must_continue, special));
+        prev_incomplete = _mm256_subs_epu8(block, incomplete_max);
+        prev = block;
+    };
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+        if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) == 0) {
+            error = _mm256_or_si256(error, prev_incomplete);
+            prev_incomplete = _mm256_setzero_si256();
+            prev = second;
+            continue;
+        }
+        check_block(first);
+        check_block(second);
+    }
+    for (; i + 32 <= size; i += 32) {
+        check_block(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+    }
+    if (i < size) {
+        // Хвіст доповнюється нулями (ASCII): обірвана послідовність дасть TOO_SHORT
+        alignas(32) char tail[32] = {};
+        std::memcpy(tail, src + i, size - i);
+        check_block(_mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+    }
+    error = _mm256_or_si256(error, prev_incomplete);
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+//! Маска байтів, що починають код UTF-8, тобто не є продовженнями 10xxxxxx:
+//! як знакові числа продовження лежать у [-128, -65], решта байтів -- більші.
+inline uint32_t avx2_lead_mask(const char* block) {
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(data, _mm256_set1_epi8(static_cast<char>(0xBF)))));
+}
+
+inline bool is_utf8_lead(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+}
+
+//! Кількість кодів UTF-8 у [src, src + size): popcount маски початкових байтів.
+inline size_t avx2_utf8_length(const char* src, size_t size) {
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        count += __builtin_popcount(avx2_lead_mask(src + i));
+    }
+    for (; i < size; ++i) {
+        count += is_utf8_lead(src[i]);
+    }
+    return count;
+}
+
+//! Зсув n-го (з нуля) коду в [src, src + size); size, якщо n -- кількість
+//! кодів, інакше my_str_avx::not_found. Блоки без потрібного коду
+//! пропускаються за їх popcount, у знайденому блоці скидаються n молодших бітів.
+inline size_t avx2_utf8_offset(const char* src, size_t size, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        uint32_t mask = avx2_lead_mask(src + i);
+        size_t const count = __builtin_popcount(mask);
+        if (n < count) {
+            for (; n > 0; --n) {
+                mask &= mask - 1;
+            }
+            return i + __builtin_ctz(mask);
+        }
+        n -= count;
+    }
+    for (; i < size; ++i) {
+        if (is_utf8_lead(src[i])) {
+            if (n == 0) {
+                return i;
+            }
+            --n;
+        }
+    }
+    return (n == 0) ? size : my_str_avx::not_found;
+}
+
+//! Декодує один код UTF-8 з [src, src + size) у code_point і повертає його
+//! довжину в байтах, або 0 для неправильної послідовності: обірваної,
+//! надлишково закодованої, сурогату чи коду понад U+10FFFF.
+inline size_t utf8_decode(const char* src, size_t size, char32_t& code_point) {
+    unsigned char const lead = static_cast<unsigned char>(src[0]);
+    if (lead < 0x80) {
+        code_point = lead;
+        return 1;
+    }
+    size_t length = 0;
+    char32_t smallest = 0;
+    if (lead >= 0xC2 && lead < 0xE0) {
+        length = 2;
+        code_point = lead & 0x1F;
+        smallest = 0x80;
+    } else if (lead >= 0xE0 && lead < 0xF0) {
+        length = 3;
+        code_point = lead & 0x0F;
+        smallest = 0x800;
+    } else if (lead >= 0xF0 && lead < 0xF5) {
+        length = 4;
+        code_point = lead & 0x07;
+        smallest = 0x10000;
+    } else {
+        return 0;
+    }
+    if (length > size) {
+        return 0;
+    }
+    for (size_t k = 1; k < length; ++k) {
+        unsigned char const next = static_cast<unsigned char>(src[k]);
+        if ((next & 0xC0) != 0x80) {
+            return 0;
+        }
+        code_point = (code_point << 6) | (next & 0x3F);
+    }
+    if (code_point < smallest || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+        return 0;
+    }
+    return length;
+}
+
+//! Записує code_point в UTF-8 і повертає кількість байтів.
+inline size_t utf8_encode(char32_t code_point, char* dst) {
+    if (code_point < 0x80) {
+        dst[0] = static_cast<char>(code_point);
+        return 1;
+    }
+    if (code_point < 0x800) {
+        dst[0] = static_cast<char>(0xC0 | (code_point >> 6));
+        dst[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+    if (code_point < 0x10000) {
+        dst[0] = static_cast<char>(0xE0 | (code_point >> 12));
+        dst[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        dst[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    dst[0] = static_cast<char>(0xF0 | (code_point >> 18));
+    dst[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    dst[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    dst[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+//! Записує code_point в UTF-16 (сурогатною парою понад U+FFFF) і
+//! повертає кількість одиниць.
+inline size_t utf16_encode(char32_t code_point, char16_t* dst) {
+    if (code_point < 0x10000) {
+        dst[0] = static_cast<char16_t>(code_point);
+        return 1;
+    }
+    code_point -= 0x10000;
+    dst[0] = static_cast<char16_t>(0xD800 | (code_point >> 10));
+    dst[1] = static_cast<char16_t>(0xDC00 | (code_point & 0x3FF));
+    return 2;
+}
+
+//! Декодує один код UTF-16 з [src, src + size) і повертає кількість
+//! одиниць, або 0 для непарного сурогату.
+inline size_t utf16_decode(const char16_t* src, size_t size, char32_t& code_point) {
+    char16_t const unit = src[0];
+    if (unit < 0xD800 || unit > 0xDFFF) {
+        code_point = unit;
+        return 1;
+    }
+    if (unit > 0xDBFF || size < 2 || src[1] < 0xDC00 || src[1] > 0xDFFF) {
+        return 0;
+    }
+    code_point = 0x10000 + ((char32_t(unit) - 0xD800) << 10) + (char32_t(src[1]) - 0xDC00);
+    return 2;
+}
+
+//! Скалярний крок перекодування UTF-8 -> UTF-16/32 для одного коду;
+//! повертає кількість прочитаних байтів (0 -- неправильна послідовність).
+template <typename Unit>
+inline size_t utf8_transcode_one(const char* src, size_t size, Unit* dst, size_t& written) {
+    char32_t code_point = 0;
+    size_t const length = utf8_decode(src, size, code_point);
+    if (length == 0) {
+        return 0;
+    }
+    if constexpr (sizeof(Unit) == 2) {
+        written += utf16_encode(code_point, dst + written);
+    } else {
+        dst[written++] = code_point;
+    }
+    return length;
+}
+
+//! UTF-8 -> UTF-16 в out. Повертає my_str_avx::not_found, або зсув першої
+//! неправильної послідовності (тоді out -- перекодований до неї префікс).
+//! ASCII-префікс кожного 32-байтового блоку розширюється нулями одразу
+//! (_mm256_cvtepu8_epi16), решта -- скалярно по одному коду. Одиниць UTF-16
+//! не більше, ніж байтів UTF-8, тож out виділяється один раз.
+inline size_t avx2_utf8_to_utf16(const char* src, size_t size, std::u16string& out) {
+    out.resize(size);
+    char16_t* dst = &out[0];
+    size_t i = 0;
+    size_t written = 0;
+    while (i < size) {
+        if (i + 32 <= size) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            uint32_t const non_ascii = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + written), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(block)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + written + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(block, 1)));
+            size_t const ascii = (non_ascii == 0) ? 32 : __builtin_ctz(non_ascii);
+            i += ascii;
+            written += ascii;
+            if (non_ascii == 0) {
+                continue;
+            }
+        }
+        size_t const length = utf8_transcode_one(src + i, size - i, dst, written);
+        if (length == 0) {
+            out.resize(written);
+            return i;
+        }
+        i += length;
+    }
+    out.resize(written);
+    return my_str_avx::not_found;
+}
+
+//! UTF-8 -> UTF-32, як avx2_utf8_to_utf16; ASCII розширюється по 8 байтів
+//! (_mm256_cvtepu8_epi32), чотири рази на 32-байтовий блок.
+inline size_t avx2_utf8_to_utf32(const char* src, size_t size, std::u32string& out) {
+    out.resize(size);
+    char32_t* dst = &out[0];
+    size_t i = 0;
+    size_t written = 0;
+    while (i < size) {
+        if (i + 32 <= size) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            uint32_t const non_ascii = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+            __m128i const low = _mm256_castsi256_si128(block);
+            __m128i const high = _mm256_extracti128_si256(block, 1);
+            __m256i* out_block = reinterpret_cast<__m256i*>(dst + written);
+            _mm256_storeu_si256(out_block, _mm256_cvtepu8_epi32(low));
+            _mm256_storeu_si256(out_block + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+            _mm256_storeu_si256(out_block + 2, _mm256_cvtepu8_epi32(high));
+            _mm256_storeu_si256(out_block + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+            size_t const ascii = (non_ascii == 0) ? 32 : __builtin_ctz(non_ascii);
+            i += ascii;
+            written += ascii;
+            if (non_ascii == 0) {
+                continue;
+            }
+        }
+        size_t const length = utf8_transcode_one(src + i, size - i, dst, written);
+        if (length == 0) {
+            out.resize(written);
+            return i;
+        }
+        i += length;
+    }
+    out.resize(written);
+    return my_str_avx::not_found;
+}
+
+//! UTF-16 -> UTF-8 у dst (місця -- щонайменше 3 байти на одиницю). Повертає
+//! my_str_avx::not_found, або індекс непарного сурогату. ASCII-префікс 16
+//! одиниць звужується одним _mm_packus_epi16.
+inline size_t avx2_utf16_to_utf8(const char16_t* src, size_t size, char* dst, size_t& written) {
+    written = 0;
+    size_t i = 0;
+    while (i < size) {
+        if (i + 16 <= size) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i ascii_units = _mm256_cmpeq_epi16(_mm256_and_si256(block, _mm256_set1_epi16(static_cast<short>(0xFF80))), _mm256_setzero_si256());
+            uint32_t const non_ascii = ~static_cast<uint32_t>(_mm256_movemask_epi8(ascii_units));
+            __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(block), _mm256_extracti128_si256(block, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + written), packed);
+            size_t const ascii = (non_ascii == 0) ? 16 : __builtin_ctz(non_ascii) / 2;
+            i += ascii;
+            written += ascii;
+            if (non_ascii == 0) {
+                continue;
+            }
+        }
+        char32_t code_point = 0;
+        size_t const length = utf16_decode(src + i, size - i, code_point);
+        if (length == 0) {
+            return i;
+        }
+        written += utf8_encode(code_point, dst + written);
+        i += length;
+    }
+    return my_str_avx::not_found;
+}
+
+//! UTF-32 -> UTF-8 у dst (місця -- щонайменше 4 байти на одиницю). Повертає
+//! my_str_avx::not_found, або індекс коду понад U+10FFFF чи сурогату.
+//! ASCII-префікс 8 одиниць звужується двома packus.
+inline size_t avx2_utf32_to_utf8(const char32_t* src, size_t size, char* dst, size_t& written) {
+    written = 0;
+    size_t i = 0;
+    while (i < size) {
+        if (i + 8 <= size) {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i ascii_units = _mm256_cmpeq_epi32(_mm256_and_si256(block, _mm256_set1_epi32(~0x7F)), _mm256_setzero_si256());
+            uint32_t const non_ascii = ~static_cast<uint32_t>(_mm256_movemask_epi8(ascii_units));
+            __m128i words = _mm_packus_epi32(_mm256_castsi256_si128(block), _mm256_extracti128_si256(block, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + written), _mm_packus_epi16(words, words));
+            size_t const ascii = (non_ascii == 0) ? 8 : __builtin_ctz(non_ascii) / 4;
+            i += ascii;
+            written += ascii;
+            if (non_ascii == 0) {
+                continue;
+            }
+        }
+        char32_t const code_point = src[i];
+        if (code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+            return i;
+        }
+        written += utf8_encode(code_point, dst + written);
+        ++i;
+    }
+    return my_str_avx::not_found;
+}
+
+//! Алфавіт base64 (RFC 4648) і зворотна таблиця для ASCII: значення
+//! літери, або 0xFF для літер поза алфавітом.
+constexpr char base64_alphabet[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct base64_table {
+    uint8_t values[128];
+
+    constexpr base64_table() : values() {
+        for (size_t k = 0; k < 128; ++k) {
+            values[k] = 0xFF;
+        }
+        for (size_t k = 0; k < 64; ++k) {
+            values[static_cast<unsigned char>(base64_alphabet[k])] = static_cast<uint8_t>(k);
+        }
+    }
+};
+
+alignas(16) constexpr base64_table base64_values{};
+
+inline uint8_t base64_value(char c) {
+    unsigned char const byte = static_cast<unsigned char>(c);
+    return byte < 128 ? base64_values.values[byte] : 0xFF;
+}
+
+//! Скалярний base64 для хвоста: повні трійки, тоді остача з '='.
+inline void base64_encode_scalar(const char* src, size_t size, char* dst) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t const triple = (uint32_t(in[i]) << 16) | (uint32_t(in[i + 1]) << 8) | in[i + 2];
+        *dst++ = base64_alphabet[triple >> 18];
+        *dst++ = base64_alphabet[(triple >> 12) & 0x3F];
+        *dst++ = base64_alphabet[(triple >> 6) & 0x3F];
+        *dst++ = base64_alphabet[triple & 0x3F];
+    }
+    if (i < size) {
+        uint32_t triple = uint32_t(in[i]) << 16;
+        if (i + 1 < size) {
+            triple |= uint32_t(in[i + 1]) << 8;
+        }
+        *dst++ = base64_alphabet[triple >> 18];
+        *dst++ = base64_alphabet[(triple >> 12) & 0x3F];
+        *dst++ = (i + 1 < size) ? base64_alphabet[(triple >> 6) & 0x3F] : '=';
+        *dst++ = '=';
+    }
+}
+
+//! Скалярне декодування base64 без '=': повні четвірки, тоді остача з 2 чи 3
+//! літер. Дописує байти в dst + written; повертає позицію першої літери поза
+//! алфавітом, або size.
+inline size_t base64_decode_scalar(const char* src, size_t size, char* dst, size_t& written) {
+    size_t i = 0;
+    while (i < size) {
+        size_t const group = (size - i < 4) ? size - i : 4;
+        uint32_t quad = 0;
+        for (size_t k = 0; k < group; ++k) {
+            uint8_t const value = base64_value(src[i + k]);
+            if (value == 0xFF) {
+                return i + k;
+            }
+            quad |= uint32_t(value) << (18 - 6 * k);
+        }
+        if (group == 1) {
+            return i;
+        }
+        for (size_t k = 0; k + 1 < group; ++k) {
+            dst[written++] = static_cast<char>(quad >> (16 - 8 * k));
+        }
+        i += group;
+    }
+    return size;
+}
+
+//! Індекси 0..63 -> літери base64 (Muła): саме діапазон індексу визначає
+//! зсув до ASCII, а номер діапазону стискається до 0..13 насиченим
+//! відніманням, тож зсув -- один _mm256_shuffle_epi8.
+inline __m256i avx2_base64_chars(__m256i indices) {
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    __m256i is_upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range, _mm256_and_si256(is_upper, _mm256_set1_epi8(13)));
+    __m256i const shift = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(shift, range), indices);
+}
+
+//! base64 з [src, src + size) у dst ((size + 2) / 3 * 4 літер). За крок -- 24
+//! байти: по 12 у кожну половину регістра, pshufb розкладає трійки на 32-бітні
+//! слова, а два множення 16-бітних половин вирізають по 6 бітів.
+inline void avx2_base64_encode(const char* src, size_t size, char* dst) {
+    __m256i const spread = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t i = 0;
+    for (; i + 28 <= size; i += 24) {
+        __m256i in = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12)), 1);
+        in = _mm256_shuffle_epi8(in, spread);
+        __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        __m256i low = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), avx2_base64_chars(_mm256_or_si256(high, low)));
+        dst += 32;
+    }
+    base64_encode_scalar(src + i, size - i, dst);
+}
+
+//! Декодує base64 без '=' (size % 4 != 1) у dst + written. Повертає
+//! my_str_avx::not_found, або позицію першої літери поза алфавітом. Перевірка
+//! і перетворення літери в 6 бітів -- три pshufb за півбайтами (Muła); блок
+//! з помилкою доходить скалярний цикл, щоб знайти її позицію.
+inline size_t avx2_base64_decode(const char* src, size_t size, char* dst, size_t& written) {
+    __m256i const lut_low = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    __m256i const lut_high = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    __m256i const lut_roll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i const mask_2f = _mm256_set1_epi8(0x2F);
+    __m256i const gather = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask_2f);
+        __m256i low = _mm256_shuffle_epi8(lut_low, _mm256_and_si256(in, mask_2f));
+        __m256i high = _mm256_shuffle_epi8(lut_high, high_nibbles);
+        if (!_mm256_testz_si256(low, high)) {
+            break;
+        }
+        __m256i is_slash = _mm256_cmpeq_epi8(in, mask_2f);
+        __m256i values = _mm256_add_epi8(in, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(is_slash, high_nibbles)));
+        __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        merged = _mm256_shuffle_epi8(merged, gather);
+        merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + written), _mm256_castsi256_si128(merged));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + written + 16), _mm256_extracti128_si256(merged, 1));
+        written += 24;
+    }
+    size_t const bad = base64_decode_scalar(src + i, size - i, dst, written);
+    return bad == size - i ? my_str_avx::not_found : i + bad;
+}
+
+constexpr char hex_digits[17] = "0123456789abcdef";
+
+//! Значення шістнадцяткової цифри (будь-якого регістру), або 0xFF.
+inline uint8_t hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    }
+    char const lower = static_cast<char>(c | 0x20);
+    if (lower >= 'a' && lower <= 'f') {
+        return static_cast<uint8_t>(lower - 'a' + 10);
+    }
+    return 0xFF;
+}
+
+inline void hex_encode_scalar(const char* src, size_t size, char* dst) {
+    for (size_t i = 0; i < size; ++i) {
+        unsigned char const byte = static_cast<unsigned char>(src[i]);
+        *dst++ = hex_digits[byte >> 4];
+        *dst++ = hex_digits[byte & 0x0F];
+    }
+}
+
+//! Пари цифр з [src, src + size) (size парне) у байти dst; повертає позицію
+//! першої нецифри, або size.
+inline size_t hex_decode_scalar(const char* src, size_t size, char* dst) {
+    for (size_t i = 0; i < size; i += 2) {
+        uint8_t const high = hex_value(src[i]);
+        if (high == 0xFF) {
+            return i;
+        }
+        uint8_t const low = hex_value(src[i + 1]);
+        if (low == 0xFF) {
+            return i + 1;
+        }
+        *dst++ = static_cast<char>((high << 4) | low);
+    }
+    return size;
+}
+
+//! Байти [src, src + size) як 2 * size шістнадцяткових цифр у dst. За крок --
+//! 32 байти: півбайти стають цифрами одним pshufb, а unpack чергує старші й
+//! молодші (permute2x128 повертає половини регістрів у порядок тексту).
+inline void avx2_hex_encode(const char* src, size_t size, char* dst) {
+    __m256i const digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex_digits)));
+    __m256i const low_nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), low_nibble));
+        __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(in, low_nibble));
+        __m256i first = _mm256_unpacklo_epi8(high, low);
+        __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    hex_encode_scalar(src + i, size - i, dst + 2 * i);
+}
+
+//! Значення 32 цифр блоку і маска нецифр: '0'..'9' та ('a'..'f' | 0x20) --
+//! два беззнакові порівняння діапазонів.
+inline __m256i avx2_hex_values(__m256i chars, uint32_t& invalid) {
+    __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i is_letter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    invalid = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)));
+    return _mm256_blendv_epi8(_mm256_add_epi8(letter, _mm256_set1_epi8(10)), digit, is_digit);
+}
+
+//! Пари цифр з [src, src + size) (size парне) у байти dst. Повертає
+//! my_str_avx::not_found, або позицію першої нецифри. Пари зливає
+//! maddubs (старший * 16 + молодший), а packus звужує до байтів.
+inline size_t avx2_hex_decode(const char* src, size_t size, char* dst) {
+    __m256i const weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        uint32_t invalid_first = 0;
+        uint32_t invalid_second = 0;
+        __m256i first = avx2_hex_values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), invalid_first);
+        __m256i second = avx2_hex_values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)), invalid_second);
+        if ((invalid_first | invalid_second) != 0) {
+            break;
+        }
+        __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i / 2), _mm256_permute4x64_epi64(bytes, 0xD8));
+    }
+    size_t const bad = hex_decode_scalar(src + i, size - i, dst + i / 2);
+    return bad == size - i ? my_str_avx::not_found : i + bad;
+}
+
+//! Літери, які треба екранувати в рядку JSON, у тексті HTML та які
+//! вимагають лапок у полі CSV.
+inline bool is_json_special(char c) {
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+inline bool is_html_special(char c) {
+    return c == '&' || c == '<' || c == '>' || c == '"' || c == '\'';
+}
+
+inline bool is_csv_special(char c) {
+    return c == ',' || c == '"' || c == '\n' || c == '\r';
+}
+
+template <typename Str>
+inline void json_escape_char(Str& out, char c) {
+    switch (c) {
+        case '"': out.append("\\\"", 2); break;
+        case '\\': out.append("\\\\", 2); break;
+        case '\n': out.append("\\n", 2); break;
+        case '\r': out.append("\\r", 2); break;
+        case '\t': out.append("\\t", 2); break;
+        case '\b': out.append("\\b", 2); break;
+        case '\f': out.append("\\f", 2); break;
+        default: {
+            unsigned char const byte = static_cast<unsigned char>(c);
+            char const code[6] = {'\\', 'u', '0', '0', hex_digits[byte >> 4], hex_digits[byte & 0x0F]};
+            out.append(code, 6);
+        }
+    }
+}
+
+template <typename Str>
+inline void html_escape_char(Str& out, char c) {
+    switch (c) {
+        case '&': out.append("&amp;", 5); break;
+        case '<': out.append("&lt;", 4); break;
+        case '>': out.append("&gt;", 4); break;
+        case '"': out.append("&quot;", 6); break;
+        default: out.append("&#39;", 5); break;
+    }
+}
+
+//! Маски особливих літер JSON, HTML і CSV у 32 байтах від block. Керівні
+//! байти JSON (< 0x20) -- одне беззнакове порівняння через min_epu8.
+inline uint32_t avx2_json_special_mask(const char* block) {
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\\')));
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(_mm256_min_epu8(data, _mm256_set1_epi8(0x1F)), data));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+inline uint32_t avx2_html_special_mask(const char* block) {
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('&')), _mm256_cmpeq_epi8(data, _mm256_set1_epi8('<')));
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('>')));
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('"')));
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\'')));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+inline uint32_t avx2_csv_special_mask(const char* block) {
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(',')), _mm256_cmpeq_epi8(data, _mm256_set1_epi8('"')));
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\n')));
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\r')));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+inline uint32_t avx2_quote_mask(const char* block) {
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('"'))));
+}
+
+//! Позиція першої особливої літери, або size: block_mask(ptr) -- маска
+//! особливих літер у 32 байтах від ptr, is_special перевіряє хвіст.
+template <typename BlockMask, typename IsSpecial>
+inline size_t avx2_find_special(const char* src, size_t size, BlockMask block_mask, IsSpecial is_special) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        uint32_t const mask = block_mask(src + i);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < size; ++i) {
+        if (is_special(src[i])) {
+            return i;
+        }
+    }
+    return size;
+}
+
+//! Дописує [src, src + size) в out, підставляючи escape(out, c) замість кожної
+//! особливої літери. Чистий блок коштує одну перевірку маски, а ділянки між
+//! особливими літерами копіюються одним векторним append.
+template <typename BlockMask, typename IsSpecial, typename Escape>
+inline void avx2_escape(const char* src, size_t size, BlockMask block_mask, IsSpecial is_special, Escape escape,
+                        my_str_avx& out) {
+    size_t start = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        uint32_t mask = block_mask(src + i);
+        while (mask != 0) {
+            size_t const pos = i + __builtin_ctz(mask);
+            out.append(src + start, pos - start);
+            escape(out, src[pos]);
+            start = pos + 1;
+            mask &= mask - 1;
+        }
+    }
+    for (; i < size; ++i) {
+        if (is_special(src[i])) {
+            out.append(src + start, i - start);
+            escape(out, src[i]);
+            start = i + 1;
+        }
+    }
+    out.append(src + start, size - start);
+}
+
+//! Маска байтів блоку з набору set (літерал, на кшталт "?#"): по одному
+//! порівнянню на літеру набору.
+template <size_t N>
+inline uint32_t avx2_any_of_mask(const char* block, const char (&set)[N]) {
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i hits = _mm256_setzero_si256();
+    for (size_t k = 0; k + 1 < N; ++k) {
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8(set[k])));
+    }
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+}
+
+//! Позиція першої літери з набору set у [src, src + size), або size.
+template <size_t N>
+inline size_t avx2_find_any_of(const char* src, size_t size, const char (&set)[N]) {
+    return avx2_find_special(src, size,
+        [&set](const char* block) { return avx2_any_of_mask(block, set); },
+        [&set](char c) { return std::char_traits<char>::find(set, N - 1, c) != nullptr; });
+}
+
+//! Пари цифр "00".."99": число форматується по дві цифри за ділення.
+constexpr char digit_pairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+//! Записує десятковий запис value, що закінчується перед end, і повертає
+//! кількість цифр (не більше 20).
+inline size_t format_uint(uint64_t value, char* end) {
+    char* pos = end;
+    while (value >= 100) {
+        size_t const pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--pos = digit_pairs[pair + 1];
+        *--pos = digit_pairs[pair];
+    }
+    if (value >= 10) {
+        *--pos = digit_pairs[value * 2 + 1];
+        *--pos = digit_pairs[value * 2];
+    } else {
+        *--pos = static_cast<char>('0' + value);
+    }
+    return static_cast<size_t>(end - pos);
+}
+
+//! Значення не більше ніж 16 цифр [src, src + size), або false для нецифри.
+//! Цифри вирівнюються праворуч у блоці з '0', перевіряються одним беззнаковим
+//! порівнянням, а зводяться множенням-додаванням: maddubs дає пари, madd --
+//! четвірки, ще один madd -- вісімки цифр.
+inline bool avx2_parse_digits16(const char* src, size_t size, uint64_t& value) {
+    alignas(16) char block[16];
+    std::memset(block, '0', 16);
+    std::memcpy(block + 16 - size, src, size);
+    __m128i digits = _mm_sub_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), _mm_set1_epi8('0'));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits)) != 0xFFFF) {
+        return false;
+    }
+    __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+    __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    __m128i octets = _mm_madd_epi16(_mm_packus_epi32(quads, quads), _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+    value = uint64_t(static_cast<uint32_t>(_mm_cvtsi128_si32(octets))) * 100000000
+          + static_cast<uint32_t>(_mm_extract_epi32(octets, 1));
+    return true;
+}
+
+//! Значення цифр [src, src + size) (непорожньо): 16 цифр за крок, старший
+//! шматок -- остача. Повертає false, якщо трапилась нецифра; overflow -- якщо
+//! значення не вміщується в uint64_t (цифри при цьому перевіряються до кінця).
+inline bool avx2_parse_uint(const char* src, size_t size, uint64_t& value, bool& overflow) {
+    overflow = false;
+    value = 0;
+    size_t pos = 0;
+    size_t length = (size % 16 == 0) ? 16 : size % 16;
+    while (pos < size) {
+        uint64_t chunk = 0;
+        if (!avx2_parse_digits16(src + pos, length, chunk)) {
+            return false;
+        }
+        if (pos != 0 && (__builtin_mul_overflow(value, 10000000000000000ull, &value) || __builtin_add_overflow(value, chunk, &value))) {
+            overflow = true;
+        } else if (pos == 0) {
+            value = chunk;
+        }
+        pos += length;
+        length = 16;
+    }
+    return true;
+}
+
+//! Швидкий шлях to_double (Clinger): [+-]цифри[.цифри][e[+-]цифри] з не
+//! більше ніж 19 значущими цифрами, мантисою до 2^53 і десятковим порядком у
+//! [-22, 22]. Тоді і мантиса, і 10^порядок точні в double, тож одне множення чи
+//! ділення дає правильно заокруглений результат. Цифри зводить parse_uint
+//! (векторно); false -- вхід поза цим шляхом, і його розбирає std::from_chars.
+template <typename ParseUint>
+inline bool parse_double_fast(const char* src, size_t size, ParseUint parse_uint, double& value) {
+    static constexpr double exact_powers[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    size_t pos = 0;
+    bool const negative = size > 0 && src[0] == '-';
+    if (size > 0 && (src[0] == '-' || src[0] == '+')) {
+        ++pos;
+    }
+    size_t const int_begin = pos;
+    while (pos < size && is_digit(src[pos])) {
+        ++pos;
+    }
+    size_t const int_length = pos - int_begin;
+    size_t frac_begin = pos;
+    if (pos < size && src[pos] == '.') {
+        frac_begin = ++pos;
+        while (pos < size && is_digit(src[pos])) {
+            ++pos;
+        }
+    }
+    size_t const frac_length = pos - frac_begin;
+    if (int_length + frac_length == 0 || int_length + frac_length > 19) {
+        return false;
+    }
+    int64_t exponent = 0;
+    if (pos < size && (src[pos] == 'e' || src[pos] == 'E')) {
+        ++pos;
+        bool const exponent_negative = pos < size && src[pos] == '-';
+        if (pos < size && (src[pos] == '-' || src[pos] == '+')) {
+            ++pos;
+        }
+        size_t const exponent_begin = pos;
+        while (pos < size && is_digit(src[pos]) && pos - exponent_begin < 4) {
+            exponent = exponent * 10 + (src[pos] - '0');
+            ++pos;
+        }
+        if (pos == exponent_begin) {
+            return false;
+        }
+        exponent = exponent_negative ? -exponent : exponent;
+    }
+    if (pos != size) {
+        return false;
+    }
+    uint64_t mantissa = 0;
+    uint64_t fraction = 0;
+    bool overflow = false;
+    if (int_length != 0) {
+        parse_uint(src + int_begin, int_length, mantissa, overflow);
+    }
+    if (frac_length != 0) {
+        parse_uint(src + frac_begin, frac_length, fraction, overflow);
+        for (size_t k = 0; k < frac_length; ++k) {
+            mantissa *= 10;
+        }
+        mantissa += fraction;
+        exponent -= static_cast<int64_t>(frac_length);
+    }
+    if (mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+        return false;
+    }
+    double result = static_cast<double>(mantissa);
+    result = exponent < 0 ? result / exact_powers[-exponent] : result * exact_powers[exponent];
+    value = negative ? -result : result;
+    return true;
+}
+
+//! Маска екранованих літер 64-байтового блоку JSON за маскою '\\' (як у
+//! simdjson): серія '\\' непарної довжини екранує наступну літеру. Серії, що
+//! починаються на непарних позиціях, виділяє додавання з переносом; prev_escaped
+//! переносить екранування через межу блоків.
+inline uint64_t json_escaped_mask(uint64_t backslash, uint64_t& prev_escaped) {
+    backslash &= ~prev_escaped;
+    uint64_t const follows_escape = (backslash << 1) | prev_escaped;
+    uint64_t const even_bits = 0x5555555555555555ull;
+    uint64_t const odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+    uint64_t sequences_starting_on_even_bits = 0;
+    prev_escaped = __builtin_add_overflow(odd_sequence_starts, backslash, &sequences_starting_on_even_bits) ? 1 : 0;
+    uint64_t const invert_mask = sequences_starting_on_even_bits << 1;
+    return (even_bits ^ invert_mask) & follows_escape;
+}
+
+//! Префіксний XOR маски (біт i -- парність бітів 0..i) як безпереносне
+//! множення на всі одиниці: один pclmulqdq.
+inline uint64_t avx2_prefix_xor(uint64_t bits) {
+    __m128i const product = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<int64_t>(bits)), _mm_set1_epi8(static_cast<char>(0xFF)), 0);
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+}
+
+//! Маски лапок, '\' і структурних літер {}[]:, у 64 байтах від block.
+inline void avx2_json_masks(const char* block, uint64_t& quote, uint64_t& backslash, uint64_t& structural) {
+    for (size_t half = 0; half < 2; ++half) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * half));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(data, _mm256_set1_epi8('}')));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8('[')));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8(']')));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8(':')));
+        hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, _mm256_set1_epi8(',')));
+        unsigned const shift = 32 * half;
+        quote |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('"'))))) << shift;
+        backslash |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('\\'))))) << shift;
+        structural |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hits))) << shift;
+    }
+}
+
+//! Індексує [src, src + size) блоками по 64 байти: лапки без екрану
+//! відкривають і закривають рядки, а структурні літери всередині рядків
+//! відкидає маска, отримана префіксним XOR. Неповний останній блок
+//! доповнюється пробілами. Повертає false, якщо рядок не закрито.
+inline bool avx2_json_index(const char* src, size_t size, std::vector<size_t>& out) {
+    out.clear();
+    uint64_t prev_escaped = 0;
+    uint64_t prev_in_string = 0;
+    alignas(32) char tail[64];
+    for (size_t i = 0; i < size; i += 64) {
+        const char* block = src + i;
+        if (size - i < 64) {
+            std::memset(tail, ' ', 64);
+            std::memcpy(tail, src + i, size - i);
+            block = tail;
+        }
+        uint64_t quote = 0;
+        uint64_t backslash = 0;
+        uint64_t structural = 0;
+        avx2_json_masks(block, quote, backslash, structural);
+        quote &= ~json_escaped_mask(backslash, prev_escaped);
+        uint64_t const in_string = avx2_prefix_xor(quote) ^ prev_in_string;
+        prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+        uint64_t bits = (structural & ~in_string) | quote;
+        while (bits != 0) {
+            out.push_back(i + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+    }
+    return prev_in_string == 0;
+}
+
+//! Маски лапок і роздільників полів (delimiter чи '\n') у 64 байтах від
+//! block; біти за межами тексту відкидаються.
+inline void avx2_csv_masks(const char* src, size_t size, size_t block, char delimiter, uint64_t& quote, uint64_t& separator) {
+    alignas(32) char tail[64];
+    const char* ptr = src + block;
+    size_t const left = size - block;
+    if (left < 64) {
+        std::memset(tail, 0, 64);
+        std::memcpy(tail, ptr, left);
+        ptr = tail;
+    }
+    quote = 0;
+    separator = 0;
+    for (size_t half = 0; half < 2; ++half) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + 32 * half));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(delimiter)), _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\n')));
+        unsigned const shift = 32 * half;
+        quote |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_set1_epi8('"'))))) << shift;
+        separator |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(hits))) << shift;
+    }
+    if (left < 64) {
+        uint64_t const valid = (uint64_t(1) << left) - 1;
+        quote &= valid;
+        separator &= valid;
+    }
+}
+
+//! Таблиця left-pack для 8 байтів: рядок m -- номери байтів, чиї біти
+//! в m встановлені, підряд від молодшого; решта рядка -- 0x80, що обнуляє байт
+//! і в pshufb, і в tbl.
+struct left_pack_table {
+    uint8_t indices[256][8];
+
+    constexpr left_pack_table() : indices() {
+        for (size_t m = 0; m < 256; ++m) {
+            size_t n = 0;
+            for (size_t bit = 0; bit < 8; ++bit) {
+                if ((m >> bit) & 1) {
+                    indices[m][n++] = static_cast<uint8_t>(bit);
+                }
+            }
+            for (; n < 8; ++n) {
+                indices[m][n] = 0x80;
+            }
+        }
+    }
+};
+
+alignas(16) constexpr left_pack_table left_pack{};
+
+//! Left-pack 32 байтів block за маскою keep у dst; повертає кількість
+//! записаних байтів. Записи по 8 байтів у межах уже прочитаного блоку, тож
+//! dst може відставати від джерела в тому самому буфері.
+inline size_t avx2_left_pack(__m256i block, uint32_t keep, char* dst) {
+    size_t written = 0;
+    for (size_t lane = 0; lane < 2; ++lane) {
+        __m128i const half = lane == 0 ? _mm256_castsi256_si128(block) : _mm256_extracti128_si256(block, 1);
+        unsigned const low = (keep >> (16 * lane)) & 0xFF;
+        unsigned const high = (keep >> (16 * lane + 8)) & 0xFF;
+        __m128i const low_indices = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(left_pack.indices[low]));
+        __m128i const high_indices = _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(left_pack.indices[high])), _mm_set1_epi8(8));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + written), _mm_shuffle_epi8(half, low_indices));
+        written += __builtin_popcount(low);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + written), _mm_shuffle_epi8(half, high_indices));
+        written += __builtin_popcount(high);
+    }
+    return written;
+}
+
+//! Стискає кожну серію ASCII-пробілів у [src, src + size) до одного ' ' і
+//! обрізає їх на початку й у кінці; повертає новий розмір. Пробіли блоку
+//! замінюються на ' ', а маска "пробіл після пробілу" відкидає зайві left-pack'ом.
+//! dst може дорівнювати src: запис ніколи не випереджає прочитане.
+inline size_t avx2_collapse_whitespace(const char* src, size_t size, char* dst) {
+    size_t written = 0;
+    uint64_t prev_space = 1; // пробіли на початку відкидаються
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i const spaces = avx2_space_bytes(block);
+        uint64_t const space = static_cast<uint32_t>(_mm256_movemask_epi8(spaces));
+        block = _mm256_blendv_epi8(block, _mm256_set1_epi8(' '), spaces);
+        uint64_t const keep = ~(space & ((space << 1) | prev_space)) & 0xFFFFFFFFu;
+        prev_space = space >> 31;
+        written += avx2_left_pack(block, static_cast<uint32_t>(keep), dst + written);
+    }
+    for (; i < size; ++i) {
+        bool const space = is_ascii_space(src[i]);
+        if (!space || !prev_space) {
+            dst[written++] = space ? ' ' : src[i];
+        }
+        prev_space = space;
+    }
+    if (prev_space && written > 0) {
+        --written;
+    }
+    return written;
+}
+
+//! Довільний набір байтів як дві таблиці по 16 байтів (перевірка належності
+//! за Muła): low[n] має біт h, якщо байт (h << 4) | n у наборі для h < 8,
+//! high[n] -- те саме для h >= 8. Рядок вибирає молодший півбайт, біт -- старший.
+struct byte_set {
+    alignas(16) uint8_t low[16];
+    alignas(16) uint8_t high[16];
+};
+
+inline byte_set make_byte_set(const char* set, size_t size) {
+    byte_set result = {};
+    for (size_t i = 0; i < size; ++i) {
+        unsigned const byte = static_cast<unsigned char>(set[i]);
+        uint8_t* rows = byte < 0x80 ? result.low : result.high;
+        rows[byte & 0x0F] |= static_cast<uint8_t>(1u << ((byte >> 4) & 7));
+    }
+    return result;
+}
+
+inline bool byte_set_contains(const byte_set& set, char c) {
+    unsigned const byte = static_cast<unsigned char>(c);
+    const uint8_t* rows = byte < 0x80 ? set.low : set.high;
+    return (rows[byte & 0x0F] >> ((byte >> 4) & 7)) & 1;
+}
+
+//! 0xFF у байтах data, що належать набору (таблиці low і high з byte_set у
+//! обох 128-бітних половинах): pshufb за молодшим півбайтом дає рядок, старший
+//! біт байта вибирає таблицю, а другий pshufb -- біт старшого півбайта.
+inline __m256i avx2_set_bytes(__m256i data, __m256i low, __m256i high) {
+    __m256i const nibble = _mm256_set1_epi8(0x0F);
+    __m256i const lo = _mm256_and_si256(data, nibble);
+    __m256i const hi = _mm256_and_si256(_mm256_srli_epi16(data, 4), nibble);
+    __m256i const rows = _mm256_blendv_epi8(_mm256_shuffle_epi8(low, lo), _mm256_shuffle_epi8(high, lo), data);
+    __m256i const bit_table = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                               1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    __m256i const bits = _mm256_shuffle_epi8(bit_table, hi);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(rows, bits), bits);
+}
+
+//! Викидає з [src, src + size) байти, для яких hits(блок) дає 0xFF (хвіст --
+//! is_removed), і left-pack'ом збирає решту в dst; повертає новий розмір.
+//! dst може дорівнювати src, тож це один лінійний прохід замість erase на байт.
+template <typename Hits, typename IsRemoved>
+inline size_t avx2_remove_if(const char* src, size_t size, char* dst, Hits hits, IsRemoved is_removed) {
+    size_t written = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i const block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        uint32_t const keep = ~static_cast<uint32_t>(_mm256_movemask_epi8(hits(block)));
+        written += avx2_left_pack(block, keep, dst + written);
+    }
+    for (; i < size; ++i) {
+        if (!is_removed(src[i])) {
+            dst[written++] = src[i];
+        }
+    }
+    return written;
+}
+
+//! Доступ до буфера читання streambuf без проміжних копій. gptr/egptr/gbump
+//! захищені, але вказівник на член, взятий через похідний клас, можна
+//! легально викликати на будь-якому std::streambuf.
+struct streambuf_window : std::streambuf {
+    static const char* begin(std::streambuf* sb) { return (sb->*&streambuf_window::gptr)(); }
+    static const char* end(std::streambuf* sb) { return (sb->*&streambuf_window::egptr)(); }
+    static void consume(std::streambuf* sb, size_t n) {
+        (sb->*&streambuf_window::gbump)(static_cast<int>(n));
+    }
+};
+
+//! Проходить буфер sb цілими блоками: find_stop шукає в блоці літеру-зупинку,
+//! усе перед нею віддається в sink одним шматком. Сама зупинка лишається в
+//! потоці. Повертає false, якщо потік закінчився раніше за зупинку.
+template <typename Finder, typename Sink>
+static bool scan_streambuf(std::streambuf* sb, Finder find_stop, Sink sink) {
+    for (;;) {
+        const char* begin = streambuf_window::begin(sb);
+        const char* end = streambuf_window::end(sb);
+        if (begin == end) {
+            int const c = sb->sgetc();
+            if (c == std::char_traits<char>::eof()) {
+                return false;
+            }
+            if (streambuf_window::begin(sb) == streambuf_window::end(sb)) {
+                // небуферизований потік (напр. std::cin з sync_with_stdio) -- по одній літері
+                char const ch = std::char_traits<char>::to_char_type(c);
+                if (find_stop(&ch, 1) == 0) {
+                    return true;
+                }
+                sink(&ch, 1);
+                sb->sbumpc();
+            }
+            continue;
+        }
+        size_t const size = end - begin;
+        size_t const pos = find_stop(begin, size);
+        sink(begin, pos);
+        streambuf_window::consume(sb, pos);
+        if (pos < size) {
+            return true;
+        }
+    }
+}
+
 my_str_avx::my_str_avx(size_t const capacity):
         capacity_m(capacity * 2 + 1), size_m(0) {
     data_m = new char[capacity_m];
@@ -25,14 +1516,8 @@ my_str_avx::my_str_avx(size_t const capacity):
 my_str_avx::my_str_avx(size_t size, char initial)
 : capacity_m(size * 2 + 1), size_m(size) {
     data_m = new char[capacity_m];
-    __m256i temp = _mm256_set1_epi8(initial);
-    size_t i=0;
-    for (; i+32 <= size_m; i+=32) {
-        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data_m + i), temp);
-    }
-    for (; i < size_m; ++i) {
-        data_m[i] = initial;
-    }
+    avx2_memset(data_m, initial, size_m);
+    data_m[size_m] = '\0';
 }
 
 my_str_avx::my_str_avx(const char* cstr) {
@@ -59,6 +1544,20 @@ my_str_avx::my_str_avx(const std::string& str) {
     data_m[size_m] = '\0';
 }
 
+my_str_avx::my_str_avx(const my_str_avx_view& view) {
+    size_m = view.size();
+    capacity_m = size_m + 1;
+    data_m = new char[capacity_m];
+    avx2_memcpy(view.data(), data_m, size_m);
+    data_m[size_m] = '\0';
+}
+
+my_str_avx::my_str_avx(const my_str_avx_view& view, validate_utf8_t) : my_str_avx(view) {
+    if (!avx2_is_valid_utf8(data_m, size_m)) {
+        throw std::invalid_argument("my_str_avx: invalid UTF-8");
+    }
+}
+
 my_str_avx::my_str_avx(const my_str_avx& my_str) 
 : capacity_m(my_str.capacity_m), size_m(my_str.size_m) {
     data_m = new char[capacity_m];  // Виділяємо пам'ять
@@ -283,16 +1782,33 @@ void my_str_avx::insert(size_t idx, const char* cstr) {
     data_m[size_m] = '\0';
 }
 
-void my_str_avx::append(char c) {
-    insert(size_m, c);
-}
-
 void my_str_avx::append (const my_str_avx& str) {
-    insert(size_m, str);
+    append(str.data_m, str.size_m);
 }
 
 void my_str_avx::append (const char* cstr) {
-    insert(size_m, cstr);
+    if (cstr == nullptr) {
+        throw std::logic_error("Null pointer passed to append()");
+    }
+    append(cstr, std::strlen(cstr));
+}
+
+void my_str_avx::append(const char* cstr, size_t len) {
+    if (len == 0) {
+        return;
+    }
+    if (size_m + len + 1 > capacity_m) {
+        // cstr може бути частиною нашого ж буфера, який reserve звільнить
+        bool const aliased = cstr >= data_m && cstr < data_m + capacity_m;
+        size_t const offset = cstr - data_m;
+        reserve(2 * (size_m + len) + 1);
+        if (aliased) {
+            cstr = data_m + offset;
+        }
+    }
+    avx2_memcpy(cstr, data_m + size_m, len);
+    size_m += len;
+    data_m[size_m] = '\0';
 }
 
 void my_str_avx::erase(size_t begin, size_t size) {
@@ -320,118 +1836,451 @@ size_t my_str_avx::find(char c, size_t idx) const {
     if (idx > size_m) {
         throw std::out_of_range("my_str_avx::find");
     }
-    const char* ptr = data_m;
-    __m256i vec = _mm256_set1_epi8(c);
-    size_t i = idx;
-    for (; i + 32 <= size_m; i += 32) {
-        __m256i data_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i));
-        __m256i cmp = _mm256_cmpeq_epi8(data_vec, vec); // use 'vec' here
+    size_t const pos = avx2_find_char(data_m + idx, size_m - idx, c);
+    return (pos == size_m - idx) ? not_found : idx + pos;
+}
 
-        int mask = _mm256_movemask_epi8(cmp);
-        if (mask != 0) {
-            return i + __builtin_ctz(mask);
-        }
-    }
-    for (; i < size_m; ++i) {
-        if (ptr[i] == c) { // use 'c' here
-            return i;
-        }
+size_t my_str_avx::find(const std::string& str, size_t idx) const {
+    if (idx > size_m) {
+        throw std::out_of_range("my_str_avx::find");
     }
-    return not_found;
+    return avx2_find_str(data_m, size_m, str.data(), str.size(), idx);
 }
 
-size_t my_str_avx::find(const std::string& str, size_t idx) const {
+size_t my_str_avx::find(const char* cstr, size_t idx) const {
+    if (cstr == nullptr) {
+        throw std::logic_error("Null pointer passed to find()");
+    }
     if (idx > size_m) {
         throw std::out_of_range("my_str_avx::find");
     }
+    return avx2_find_str(data_m, size_m, cstr, std::strlen(cstr), idx);
+}
 
-    size_t str_len = str.size();
-    if (str_len == 0) return idx;
-    if (str_len > size_m - idx) return not_found;
+void my_str_avx::split(char delim, std::vector<my_str_avx_view>& out) const {
+    my_str_avx_view(*this).split(delim, out);
+}
 
-    const char* src = data_m;
-    char target = str[0];
-    __m256i target_vec = _mm256_set1_epi8(target);
-    size_t i = idx;
+void my_str_avx::split_any(my_str_avx_view charset, std::vector<my_str_avx_view>& out) const {
+    my_str_avx_view(*this).split_any(charset, out);
+}
 
-    for (; i + 32 <= size_m; i += 32) {
-        __m256i data_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
-        __m256i cmp = _mm256_cmpeq_epi8(data_vec, target_vec);
-        int mask = _mm256_movemask_epi8(cmp);
+my_str_avx my_str_avx::concat(std::initializer_list<my_str_avx_view> pieces) {
+    return join(pieces);
+}
 
-        while (mask != 0) {
-            int offset = __builtin_ctz(mask);
-            size_t candidate = i + offset;
+void my_str_avx::to_upper() {
+    avx2_flip_case(data_m, data_m, size_m, 'a', 'z');
+}
 
-            if (candidate + str_len <= size_m &&
-                // Використовуємо memcmp для швидкодії. Інший варіант писати свій аналог що буде повільнішим
-                std::memcmp(src + candidate, str.data(), str_len) == 0) {
-                return candidate;
-            }
+void my_str_avx::to_lower() {
+    avx2_flip_case(data_m, data_m, size_m, 'A', 'Z');
+}
 
-            mask &= (mask - 1);
-        }
+my_str_avx my_str_avx::to_upper_copy() const {
+    my_str_avx result;
+    result.reserve(size_m + 1);
+    avx2_flip_case(data_m, result.data_m, size_m, 'a', 'z');
+    result.size_m = size_m;
+    result.data_m[size_m] = '\0';
+    return result;
+}
+
+my_str_avx my_str_avx::to_lower_copy() const {
+    my_str_avx result;
+    result.reserve(size_m + 1);
+    avx2_flip_case(data_m, result.data_m, size_m, 'A', 'Z');
+    result.size_m = size_m;
+    result.data_m[size_m] = '\0';
+    return result;
+}
+
+void my_str_avx::ltrim() {
+    my_str_avx_view const rest = my_str_avx_view(*this).ltrim();
+    std::memmove(data_m, rest.data(), rest.size());
+    size_m = rest.size();
+    data_m[size_m] = '\0';
+}
+
+void my_str_avx::rtrim() {
+    size_m = my_str_avx_view(*this).rtrim().size();
+    data_m[size_m] = '\0';
+}
+
+void my_str_avx::trim() {
+    rtrim();
+    ltrim();
+}
+
+my_str_avx my_str_avx::ltrim_copy() const {
+    return my_str_avx(my_str_avx_view(*this).ltrim());
+}
+
+my_str_avx my_str_avx::rtrim_copy() const {
+    return my_str_avx(my_str_avx_view(*this).rtrim());
+}
+
+my_str_avx my_str_avx::trim_copy() const {
+    return my_str_avx(my_str_avx_view(*this).trim());
+}
+
+void my_str_avx::collapse_whitespace() {
+    size_m = avx2_collapse_whitespace(data_m, size_m, data_m);
+    data_m[size_m] = '\0';
+}
+
+my_str_avx my_str_avx::collapse_whitespace_copy() const {
+    my_str_avx result;
+    result.reserve(size_m + 1);
+    result.size_m = avx2_collapse_whitespace(data_m, size_m, result.data_m);
+    result.data_m[result.size_m] = '\0';
+    return result;
+}
+
+void my_str_avx::remove(char c) {
+    __m256i const target = _mm256_set1_epi8(c);
+    size_m = avx2_remove_if(data_m, size_m, data_m,
+        [target](__m256i block) { return _mm256_cmpeq_epi8(block, target); },
+        [c](char byte) { return byte == c; });
+    data_m[size_m] = '\0';
+}
+
+void my_str_avx::remove_any(my_str_avx_view charset) {
+    byte_set const set = make_byte_set(charset.data(), charset.size());
+    __m256i const low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.low)));
+    __m256i const high = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.high)));
+    size_m = avx2_remove_if(data_m, size_m, data_m,
+        [low, high](__m256i block) { return avx2_set_bytes(block, low, high); },
+        [&set](char byte) { return byte_set_contains(set, byte); });
+    data_m[size_m] = '\0';
+}
+
+void my_str_avx::replace(size_t pos, size_t len, my_str_avx_view str) {
+    if (pos > size_m) {
+        throw std::out_of_range("my_str_avx::replace");
+    }
+    if (len > size_m - pos) {
+        len = size_m - pos;
     }
+    size_t const tail = size_m - pos - len;
+    size_t const new_size = size_m - len + str.size();
+    std::less<const char*> const before;
+    bool const aliased = !before(str.data(), data_m) && before(str.data(), data_m + capacity_m);
+    if (new_size + 1 > capacity_m || aliased) {
+        size_t const new_capacity = (new_size + 1 > capacity_m) ? 2 * new_size + 1 : capacity_m;
+        char* new_data = new char[new_capacity];
+        avx2_memcpy(data_m, new_data, pos);
+        avx2_memcpy(str.data(), new_data + pos, str.size());
+        avx2_memcpy(data_m + pos + len, new_data + pos + str.size(), tail);
+        delete[] data_m;
+        data_m = new_data;
+        capacity_m = new_capacity;
+    } else {
+        std::memmove(data_m + pos + str.size(), data_m + pos + len, tail);
+        avx2_memcpy(str.data(), data_m + pos, str.size());
+    }
+    size_m = new_size;
+    data_m[size_m] = '\0';
+}
 
-    for (; i <= size_m - str_len; ++i) {
-        if (src[i] == target &&
-            // Використовуємо memcmp для швидкодії. Інший варіант писати свій аналог що буде повільнішим
-            std::memcmp(src + i, str.data(), str_len) == 0) {
-            return i;
+size_t my_str_avx::replace_all(my_str_avx_view from, my_str_avx_view to) {
+    if (from.empty()) {
+        return 0;
+    }
+    std::vector<size_t> matches;
+    for (size_t pos = avx2_find_str(data_m, size_m, from.data(), from.size(), 0); pos != not_found;
+         pos = avx2_find_str(data_m, size_m, from.data(), from.size(), pos + from.size())) {
+        matches.push_back(pos);
+    }
+    if (matches.empty()) {
+        return 0;
+    }
+    size_t const new_size = size_m - matches.size() * from.size() + matches.size() * to.size();
+    std::less<const char*> const before;
+    bool const aliased = !before(to.data(), data_m) && before(to.data(), data_m + capacity_m);
+    // Коротша заміна пишеться на місці: запис не обганяє читання, а пряме
+    // копіювання блоками вперед безпечне, коли dst <= src.
+    bool const in_place = to.size() <= from.size() && !aliased;
+    char* out = in_place ? data_m : new char[new_size + 1];
+    size_t read = 0;
+    size_t write = 0;
+    for (size_t match : matches) {
+        avx2_memcpy(data_m + read, out + write, match - read);
+        write += match - read;
+        avx2_memcpy(to.data(), out + write, to.size());
+        write += to.size();
+        read = match + from.size();
+    }
+    avx2_memcpy(data_m + read, out + write, size_m - read);
+    if (!in_place) {
+        delete[] data_m;
+        data_m = out;
+        capacity_m = new_size + 1;
+    }
+    size_m = new_size;
+    data_m[size_m] = '\0';
+    return matches.size();
+}
+
+void my_str_avx::translate(const uint8_t table[256]) {
+    avx2_translate(data_m, size_m, table);
+}
+
+bool my_str_avx::is_valid_utf8() const {
+    return avx2_is_valid_utf8(data_m, size_m);
+}
+
+size_t my_str_avx::utf8_length() const {
+    return my_str_avx_view(*this).utf8_length();
+}
+
+size_t my_str_avx::utf8_offset(size_t n) const {
+    return my_str_avx_view(*this).utf8_offset(n);
+}
+
+std::u16string my_str_avx::to_utf16() const {
+    return my_str_avx_view(*this).to_utf16();
+}
+
+std::u32string my_str_avx::to_utf32() const {
+    return my_str_avx_view(*this).to_utf32();
+}
+
+size_t my_str_avx::to_utf16(std::u16string& out) const {
+    return my_str_avx_view(*this).to_utf16(out);
+}
+
+size_t my_str_avx::to_utf32(std::u32string& out) const {
+    return my_str_avx_view(*this).to_utf32(out);
+}
+
+my_str_avx my_str_avx::from_utf16(const char16_t* src, size_t size) {
+    my_str_avx result;
+    result.reserve(3 * size + 1);
+    size_t written = 0;
+    size_t const bad = avx2_utf16_to_utf8(src, size, result.data_m, written);
+    if (bad != not_found) {
+        throw std::invalid_argument("my_str_avx::from_utf16: unpaired surrogate at " + std::to_string(bad));
+    }
+    result.size_m = written;
+    result.data_m[written] = '\0';
+    return result;
+}
+
+my_str_avx my_str_avx::from_utf16(const std::u16string& src) {
+    return from_utf16(src.data(), src.size());
+}
+
+my_str_avx my_str_avx::from_utf32(const char32_t* src, size_t size) {
+    my_str_avx result;
+    result.reserve(4 * size + 1);
+    size_t written = 0;
+    size_t const bad = avx2_utf32_to_utf8(src, size, result.data_m, written);
+    if (bad != not_found) {
+        throw std::invalid_argument("my_str_avx::from_utf32: invalid code point at " + std::to_string(bad));
+    }
+    result.size_m = written;
+    result.data_m[written] = '\0';
+    return result;
+}
+
+my_str_avx my_str_avx::from_utf32(const std::u32string& src) {
+    return from_utf32(src.data(), src.size());
+}
+
+my_str_avx my_str_avx::base64_encode() const {
+    my_str_avx result;
+    size_t const encoded = (size_m + 2) / 3 * 4;
+    result.reserve(encoded + 1);
+    avx2_base64_encode(data_m, size_m, result.data_m);
+    result.size_m = encoded;
+    result.data_m[encoded] = '\0';
+    return result;
+}
+
+my_str_avx my_str_avx::base64_decode(base64_mode mode) const {
+    const char* src = data_m;
+    size_t size = size_m;
+    std::string compact;
+    if (mode == base64_mode::lenient && avx2_find_space(src, size) != size) {
+        compact.reserve(size);
+        for (size_t pos = 0; pos < size;) {
+            size_t const run = avx2_find_space(src + pos, size - pos);
+            compact.append(src + pos, run);
+            pos += run;
+            pos += avx2_find_space(src + pos, size - pos, false);
         }
+        src = compact.data();
+        size = compact.size();
+    }
+    if (mode == base64_mode::strict && size % 4 != 0) {
+        throw std::invalid_argument("my_str_avx::base64_decode: length is not a multiple of 4");
+    }
+    size_t body = size;
+    for (size_t k = 0; k < 2 && body > 0 && src[body - 1] == '='; ++k) {
+        --body;
+    }
+    size_t const tail = body % 4;
+    if (tail == 1) {
+        throw std::invalid_argument("my_str_avx::base64_decode: truncated input");
     }
+    size_t const decoded = body / 4 * 3 + (tail == 0 ? 0 : tail - 1);
+    my_str_avx result;
+    result.reserve(decoded + 1);
+    size_t written = 0;
+    size_t const bad = avx2_base64_decode(src, body, result.data_m, written);
+    if (bad != not_found) {
+        throw std::invalid_argument("my_str_avx::base64_decode: invalid character at " + std::to_string(bad));
+    }
+    if (mode == base64_mode::strict && tail != 0 && (base64_value(src[body - 1]) & (tail == 2 ? 0x0F : 0x03)) != 0) {
+        throw std::invalid_argument("my_str_avx::base64_decode: non-zero trailing bits");
+    }
+    result.size_m = decoded;
+    result.data_m[decoded] = '\0';
+    return result;
+}
 
-    return not_found;
+my_str_avx my_str_avx::to_hex() const {
+    my_str_avx result;
+    result.reserve(2 * size_m + 1);
+    avx2_hex_encode(data_m, size_m, result.data_m);
+    result.size_m = 2 * size_m;
+    result.data_m[result.size_m] = '\0';
+    return result;
 }
 
-size_t my_str_avx::find(const char* cstr, size_t idx) const {
-    if (cstr == nullptr) {
-        throw std::logic_error("Null pointer passed to find()");
+my_str_avx my_str_avx::from_hex(my_str_avx_view hex) {
+    if (hex.size() % 2 != 0) {
+        throw std::invalid_argument("my_str_avx::from_hex: odd number of digits");
     }
-    if (idx > size_m) {
-        throw std::out_of_range("my_str_avx::find");
+    my_str_avx result;
+    result.reserve(hex.size() / 2 + 1);
+    size_t const bad = avx2_hex_decode(hex.data(), hex.size(), result.data_m);
+    if (bad != not_found) {
+        throw std::invalid_argument("my_str_avx::from_hex: invalid digit at " + std::to_string(bad));
     }
-    size_t str_len = std::strlen(cstr);
-    if (str_len == 0) {
-        return idx;
+    result.size_m = hex.size() / 2;
+    result.data_m[result.size_m] = '\0';
+    return result;
+}
+
+my_str_avx my_str_avx::escape_json() const {
+    my_str_avx result;
+    result.reserve(size_m + size_m / 8 + 1);
+    avx2_escape(data_m, size_m, avx2_json_special_mask, is_json_special, json_escape_char<my_str_avx>, result);
+    return result;
+}
+
+my_str_avx my_str_avx::escape_html() const {
+    my_str_avx result;
+    result.reserve(size_m + size_m / 8 + 1);
+    avx2_escape(data_m, size_m, avx2_html_special_mask, is_html_special, html_escape_char<my_str_avx>, result);
+    return result;
+}
+
+my_str_avx my_str_avx::escape_csv() const {
+    if (avx2_find_special(data_m, size_m, avx2_csv_special_mask, is_csv_special) == size_m) {
+        return *this;
     }
-    if (str_len > size_m - idx) {
-        return not_found;
+    my_str_avx result;
+    result.reserve(size_m + size_m / 8 + 3);
+    result.append('"');
+    avx2_escape(data_m, size_m, avx2_quote_mask,
+        [](char c) { return c == '"'; },
+        [](my_str_avx& out, char) { out.append("\"\"", 2); },
+        result);
+    result.append('"');
+    return result;
+}
+
+my_str_avx my_str_avx::url_decode(bool plus_as_space) const {
+    my_str_avx result;
+    result.reserve(size_m + 1);
+    size_t pos = 0;
+    while (pos < size_m) {
+        size_t const next = pos + (plus_as_space ? avx2_find_any_of(data_m + pos, size_m - pos, "%+")
+                                                 : avx2_find_char(data_m + pos, size_m - pos, '%'));
+        result.append(data_m + pos, next - pos);
+        if (next == size_m) {
+            break;
+        }
+        if (data_m[next] == '+') {
+            result.append(' ');
+            pos = next + 1;
+            continue;
+        }
+        uint8_t const high = (next + 2 < size_m) ? hex_value(data_m[next + 1]) : 0xFF;
+        uint8_t const low = (high != 0xFF) ? hex_value(data_m[next + 2]) : 0xFF;
+        if (low == 0xFF) {
+            throw std::invalid_argument("my_str_avx::url_decode: malformed escape at " + std::to_string(next));
+        }
+        result.append(static_cast<char>((high << 4) | low));
+        pos = next + 3;
     }
-    
-    const char* src = data_m;
-    char target = cstr[0];
-    __m256i target_vec = _mm256_set1_epi8(target);
-    size_t i = idx;
+    return result;
+}
+
+my_str_avx_url my_str_avx::parse_url() const {
+    return my_str_avx_view(*this).parse_url();
+}
+
+int64_t my_str_avx::to_int64() const {
+    return my_str_avx_view(*this).to_int64();
+}
 
-    for (; i + 32 <= size_m; i += 32) {
-        __m256i data_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
-        __m256i cmp = _mm256_cmpeq_epi8(data_vec, target_vec);
-        int mask = _mm256_movemask_epi8(cmp);
+uint64_t my_str_avx::to_uint64() const {
+    return my_str_avx_view(*this).to_uint64();
+}
+
+void my_str_avx::append_int(int64_t value) {
+    char digits[21];
+    uint64_t const magnitude = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    size_t length = format_uint(magnitude, digits + 21);
+    if (value < 0) {
+        digits[20 - length++] = '-';
+    }
+    append(digits + 21 - length, length);
+}
+
+void my_str_avx::append_uint(uint64_t value) {
+    char digits[20];
+    size_t const length = format_uint(value, digits + 20);
+    append(digits + 20 - length, length);
+}
+
+my_str_avx my_str_avx::from_int(int64_t value) {
+    my_str_avx result;
+    result.reserve(21);
+    result.append_int(value);
+    return result;
+}
 
-        while (mask != 0) {
-            int offset = __builtin_ctz(mask);
-            size_t candidate = i + offset;
+my_str_avx my_str_avx::from_uint(uint64_t value) {
+    my_str_avx result;
+    result.reserve(21);
+    result.append_uint(value);
+    return result;
+}
 
-            if (candidate + str_len <= size_m &&
-                // Використовуємо memcmp для швидкодії. Інший варіант писати свій аналог що буде повільнішим
-                std::memcmp(src + candidate, cstr, str_len) == 0) {
-                return candidate;
-            }
+double my_str_avx::to_double() const {
+    return my_str_avx_view(*this).to_double();
+}
 
-            mask &= (mask - 1);
-        }
-    }
+void my_str_avx::json_index(std::vector<size_t>& out) const {
+    my_str_avx_view(*this).json_index(out);
+}
 
-    for (; i <= size_m - str_len; ++i) {
-        if (src[i] == target &&
-            // Використовуємо memcmp для швидкодії. Інший варіант писати свій аналог що буде повільнішим
-            std::memcmp(src + i, cstr, str_len) == 0) {
-            return i;
-        }
-    }
+void my_str_avx::append_double(double value) {
+    char digits[32];
+    std::to_chars_result const result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, static_cast<size_t>(result.ptr - digits));
+}
 
-    return not_found;
+my_str_avx my_str_avx::from_double(double value) {
+    my_str_avx result;
+    result.reserve(32);
+    result.append_double(value);
+    return result;
 }
 
 my_str_avx my_str_avx::substr(size_t begin, size_t size) const {
@@ -466,21 +2315,51 @@ std::ostream& operator<<(std::ostream& stream, const my_str_avx& str) {
 }
 
 std::istream& operator>>(std::istream& stream, my_str_avx& str) {
-    while (std::isspace(stream.get())) {}
-    stream.unget();
+    std::istream::sentry guard(stream, true);
+    if (!guard) {
+        return stream;
+    }
     str.clear();
-    while (!std::isspace(stream.peek()) && !stream.eof() && !stream.fail())
-    {
-        str.append(static_cast<char>(stream.get()));
+    std::streambuf* sb = stream.rdbuf();
+    auto find_word = [](const char* src, size_t size) { return avx2_find_space(src, size, false); };
+    auto find_blank = [](const char* src, size_t size) { return avx2_find_space(src, size, true); };
+    auto skip = [](const char*, size_t) {};
+    auto append = [&str](const char* src, size_t size) { str.append(src, size); };
+
+    bool more = true;
+    if (stream.flags() & std::ios_base::skipws) {
+        more = scan_streambuf(sb, find_word, skip);
+    }
+    if (more) {
+        more = scan_streambuf(sb, find_blank, append);
     }
+    std::ios_base::iostate state = more ? std::ios_base::goodbit : std::ios_base::eofbit;
+    if (str.size() == 0) {
+        state |= std::ios_base::failbit;
+    }
+    stream.setstate(state);
     return stream;
 }
 
+//! Як std::getline: '\n' забирається з потоку, але не потрапляє в str.
+//! Рядок без '\n' в кінці файлу повертається з eofbit; failbit -- лише
+//! якщо не прочитано жодної літери.
 std::istream& readline(std::istream& stream, my_str_avx& str) {
     str.clear();
-    for (size_t i = 0; stream.peek() != '\n'; i++)
-    {
-        str.append(static_cast<char>(stream.get()));
+    std::istream::sentry guard(stream, true);
+    if (!guard) {
+        return stream;
+    }
+    std::streambuf* sb = stream.rdbuf();
+    auto find_newline = [](const char* src, size_t size) { return avx2_find_char(src, size, '\n'); };
+    auto append = [&str](const char* src, size_t size) { str.append(src, size); };
+
+    if (scan_streambuf(sb, find_newline, append)) {
+        sb->sbumpc();
+    } else if (str.size() == 0) {
+        stream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+    } else {
+        stream.setstate(std::ios_base::eofbit);
     }
     return stream;
 }
@@ -489,25 +2368,7 @@ bool operator==(const my_str_avx &str1, const my_str_avx &str2) {
     if (str1.size() != str2.size()) {
         return false;
     }
-    size_t size = str1.size();
-    const char* p1 = str1.c_str();
-    const char* p2 = str2.c_str();
-
-    size_t i = 0;
-    for (; i + 32 <= size; i += 32) {
-        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p1 + i));
-        __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p2 + i));
-        __m256i cmp = _mm256_cmpeq_epi8(v1, v2);
-        if (_mm256_movemask_epi8(cmp) != -1) { // all bits must be 1 (== 0xFFFFFFFF)
-            return false;
-        }
-    }
-    for (; i < size; ++i) {
-        if (p1[i] != p2[i]) {
-            return false;
-        }
-    }
-    return true;
+    return avx2_equal(str1.c_str(), str2.c_str(), str1.size());
 }
 
 bool operator==(const my_str_avx &str1, const char* cstr2) {
@@ -515,25 +2376,7 @@ bool operator==(const my_str_avx &str1, const char* cstr2) {
     if (size != std::strlen(cstr2)) {
         return false;
     }
-    
-    const char* p1 = str1.c_str();
-    const char* p2 = cstr2;
-
-    size_t i = 0;
-    for (; i + 32 <= size; i += 32) {
-        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p1 + i));
-        __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p2 + i));
-        __m256i cmp = _mm256_cmpeq_epi8(v1, v2);
-        if (_mm256_movemask_epi8(cmp) != -1) { // all bits must be 1 (== 0xFFFFFFFF)
-            return false;
-        }
-    }
-    for (; i < size; ++i) {
-        if (p1[i] != p2[i]) {
-            return false;
-        }
-    }
-    return true;
+    return avx2_equal(str1.c_str(), cstr2, size);
 }
 
 bool operator==(const char* cstr1, const my_str_avx& str2) {
@@ -541,25 +2384,7 @@ bool operator==(const char* cstr1, const my_str_avx& str2) {
     if (std::strlen(cstr1) != size) {
         return false;
     }
-    
-    const char* p1 = cstr1;
-    const char* p2 = str2.c_str();
-
-    size_t i = 0;
-    for (; i + 32 <= size; i += 32) {
-        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p1 + i));
-        __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p2 + i));
-        __m256i cmp = _mm256_cmpeq_epi8(v1, v2);
-        if (_mm256_movemask_epi8(cmp) != -1) {
-            return false;
-        }
-    }
-    for (; i < size; ++i) {
-        if (p1[i] != p2[i]) {
-            return false;
-        }
-    }
-    return true;
+    return avx2_equal(cstr1, str2.c_str(), size);
 }
 bool operator!=(const my_str_avx& str1, const my_str_avx& str2) {
     return !(str1==str2);
@@ -666,20 +2491,17 @@ my_str_avx& my_str_avx::operator+=(const char* mystr) {
     return *this;
 }
 
+//! Одна точна алокація замість копії mystr і дописування з перевиділенням.
 my_str_avx operator+(const my_str_avx& mystr, const my_str_avx& mystr2) {
-    my_str_avx temp(mystr);
-    temp += mystr2;
-    return temp;
+    return my_str_avx::concat({mystr, mystr2});
 }
 
 my_str_avx operator+(const my_str_avx& mystr, const char* mystr2) {
-    my_str_avx temp(mystr);
-    temp += mystr2;
-    return temp;
+    return my_str_avx::concat({mystr, mystr2});
 }
 
 my_str_avx operator+(const char* mystr, const my_str_avx& mystr2) {
-    return mystr2 + mystr;
+    return my_str_avx::concat({mystr, mystr2});
 }
 
 my_str_avx operator+(const my_str_avx& mystr, const char chr) {
@@ -689,37 +2511,83 @@ my_str_avx operator+(const my_str_avx& mystr, const char chr) {
 }
 
 my_str_avx operator+(const char chr, const my_str_avx& mystr) {
-    return mystr + chr;
+    return my_str_avx::concat({my_str_avx_view(&chr, 1), mystr});
+}
+
+my_str_avx operator+(my_str_avx&& mystr, const my_str_avx& mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+my_str_avx operator+(my_str_avx&& mystr, my_str_avx&& mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+my_str_avx operator+(my_str_avx&& mystr, const char* mystr2) {
+    mystr.append(mystr2);
+    return std::move(mystr);
+}
+
+my_str_avx operator+(my_str_avx&& mystr, const char chr) {
+    mystr.append(chr);
+    return std::move(mystr);
+}
+
+my_str_avx operator+(const my_str_avx& mystr, my_str_avx&& mystr2) {
+    if (&mystr == &mystr2) {
+        return mystr + static_cast<const my_str_avx&>(mystr2);
+    }
+    mystr2.insert(0, mystr);
+    return std::move(mystr2);
 }
 
+my_str_avx operator+(const char* mystr, my_str_avx&& mystr2) {
+    mystr2.insert(0, mystr);
+    return std::move(mystr2);
+}
+
+my_str_avx operator+(const char chr, my_str_avx&& mystr2) {
+    mystr2.insert(0, chr);
+    return std::move(mystr2);
+}
+
+//! Повторення подвоєнням: копіюємо вже побудований префікс сам на себе,
+//! тож потрібно лише log2(count) векторних копій і одна точна алокація.
 my_str_avx& my_str_avx::operator*=(int const count) {
     if (count < 0)
     {
         throw(std::invalid_argument("my_str_t::operator*=(int const count)"));
     }
-    reserve(2 * (size_m * count) + 1);
-    my_str_avx const str_copy(*this);
-    for(int i = 1; i < count; ++i)
-    {
-        append(str_copy);
+    size_t const unit = size_m;
+    size_t const new_size = unit * count;
+    reserve(new_size + 1);
+    if (unit == 1 && new_size > 1) {
+        avx2_memset(data_m + 1, data_m[0], new_size - 1);
+    } else {
+        size_t filled = (new_size < unit) ? new_size : unit;
+        while (filled < new_size) {
+            size_t const chunk = (filled < new_size - filled) ? filled : new_size - filled;
+            avx2_memcpy(data_m, data_m + filled, chunk);
+            filled += chunk;
+        }
     }
-    size_m = str_copy.size_m * count;
+    size_m = new_size;
     data_m[size_m] = '\0';
     return *this;
-};
+}
 
 my_str_avx operator*(const my_str_avx& str1, int const count) {
     if (count < 0)
     {
         throw(std::invalid_argument("my_str_t::operator*=(int const count)"));
     }
-    my_str_avx result(str1);
-    result.reserve(2 * (result.size() * count) + 1);
-    for (int i = 1; i < count; ++i)
-    {
+    my_str_avx result;
+    if (count > 0) {
+        result.reserve(str1.size() * count + 1);
         result.append(str1);
+        result *= count;
     }
-    result.resize(str1.size() * count);
     return result;
 }
 
@@ -748,6 +2616,475 @@ my_str_avx& my_str_avx::operator=(my_str_avx&& other_str) noexcept {
     other_str.capacity_m = 0;
     return *this;
 }
+
+my_str_avx_view::my_str_avx_view() noexcept : data_m(""), size_m(0) {}
+
+my_str_avx_view::my_str_avx_view(const char* data, size_t size) noexcept
+: data_m(data), size_m(size) {}
+
+my_str_avx_view::my_str_avx_view(const char* cstr) {
+    if (cstr == nullptr) {
+        throw std::logic_error("Null pointer passed to constructor");
+    }
+    data_m = cstr;
+    size_m = std::strlen(cstr);
+}
+
+my_str_avx_view::my_str_avx_view(const my_str_avx& str) noexcept
+: data_m(str.c_str()), size_m(str.size()) {}
+
+const char& my_str_avx_view::operator[](size_t idx) const {
+    if (idx >= size_m) {
+        throw std::out_of_range("Incorrect index!");
+    }
+    return data_m[idx];
+}
+
+const char& my_str_avx_view::at(size_t idx) const {
+    if (idx >= size_m) {
+        throw std::out_of_range("Incorrect index!");
+    }
+    return data_m[idx];
+}
+
+my_str_avx_view my_str_avx_view::substr(size_t begin, size_t size) const {
+    if (begin > size_m) {
+        throw std::out_of_range("Incorrect index!");
+    }
+    return {data_m + begin, (size > size_m - begin) ? size_m - begin : size};
+}
+
+size_t my_str_avx_view::find(char c, size_t idx) const {
+    if (idx > size_m) {
+        throw std::out_of_range("my_str_avx_view::find");
+    }
+    size_t const pos = avx2_find_char(data_m + idx, size_m - idx, c);
+    return (pos == size_m - idx) ? not_found : idx + pos;
+}
+
+size_t my_str_avx_view::find(my_str_avx_view str, size_t idx) const {
+    if (idx > size_m) {
+        throw std::out_of_range("my_str_avx_view::find");
+    }
+    return avx2_find_str(data_m, size_m, str.data_m, str.size_m, idx);
+}
+
+size_t my_str_avx_view::find(const std::string& str, size_t idx) const {
+    return find(my_str_avx_view(str.data(), str.size()), idx);
+}
+
+size_t my_str_avx_view::find(const char* cstr, size_t idx) const {
+    return find(my_str_avx_view(cstr), idx);
+}
+
+void my_str_avx_view::split(char delim, std::vector<my_str_avx_view>& out) const {
+    __m256i const target = _mm256_set1_epi8(delim);
+    avx2_split(data_m, size_m,
+        [target](const char* block) {
+            return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), target)));
+        },
+        [delim](char c) { return c == delim; }, out);
+}
+
+void my_str_avx_view::split_any(my_str_avx_view charset, std::vector<my_str_avx_view>& out) const {
+    bool is_delim[256] = {};
+    for (size_t i = 0; i < charset.size_m; ++i) {
+        is_delim[static_cast<unsigned char>(charset.data_m[i])] = true;
+    }
+    auto delim_char = [&is_delim](char c) { return is_delim[static_cast<unsigned char>(c)]; };
+    if (charset.size_m > split_set_limit) {
+        avx2_split(data_m, size_m,
+            [&delim_char](const char* block) {
+                uint32_t mask = 0;
+                for (size_t i = 0; i < 32; ++i) {
+                    mask |= uint32_t(delim_char(block[i])) << i;
+                }
+                return mask;
+            },
+            delim_char, out);
+        return;
+    }
+    __m256i targets[split_set_limit];
+    size_t const count = charset.size_m;
+    for (size_t i = 0; i < count; ++i) {
+        targets[i] = _mm256_set1_epi8(charset.data_m[i]);
+    }
+    avx2_split(data_m, size_m,
+        [&targets, count](const char* block) {
+            __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            __m256i hits = _mm256_setzero_si256();
+            for (size_t i = 0; i < count; ++i) {
+                hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(data, targets[i]));
+            }
+            return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        },
+        delim_char, out);
+}
+
+my_str_avx_view my_str_avx_view::ltrim() const {
+    size_t const begin = avx2_find_space(data_m, size_m, false);
+    return {data_m + begin, size_m - begin};
+}
+
+my_str_avx_view my_str_avx_view::rtrim() const {
+    return {data_m, avx2_rfind_nonspace(data_m, size_m)};
+}
+
+my_str_avx_view my_str_avx_view::trim() const {
+    return ltrim().rtrim();
+}
+
+bool my_str_avx_view::is_valid_utf8() const {
+    return avx2_is_valid_utf8(data_m, size_m);
+}
+
+size_t my_str_avx_view::utf8_length() const {
+    return avx2_utf8_length(data_m, size_m);
+}
+
+size_t my_str_avx_view::utf8_offset(size_t n) const {
+    size_t const offset = avx2_utf8_offset(data_m, size_m, n);
+    if (offset == not_found) {
+        throw std::out_of_range("my_str_avx_view::utf8_offset");
+    }
+    return offset;
+}
+
+std::u16string my_str_avx_view::to_utf16() const {
+    std::u16string out;
+    if (avx2_utf8_to_utf16(data_m, size_m, out) != not_found) {
+        throw std::invalid_argument("my_str_avx_view::to_utf16");
+    }
+    return out;
+}
+
+std::u32string my_str_avx_view::to_utf32() const {
+    std::u32string out;
+    if (avx2_utf8_to_utf32(data_m, size_m, out) != not_found) {
+        throw std::invalid_argument("my_str_avx_view::to_utf32");
+    }
+    return out;
+}
+
+size_t my_str_avx_view::to_utf16(std::u16string& out) const {
+    return avx2_utf8_to_utf16(data_m, size_m, out);
+}
+
+size_t my_str_avx_view::to_utf32(std::u32string& out) const {
+    return avx2_utf8_to_utf32(data_m, size_m, out);
+}
+
+my_str_avx_url my_str_avx_view::parse_url() const {
+    my_str_avx_url url;
+    size_t pos = 0;
+    size_t const first = avx2_find_any_of(data_m, size_m, ":/?#");
+    if (first < size_m && first > 0 && data_m[first] == ':') {
+        url.scheme = {data_m, first};
+        pos = first + 1;
+    }
+    if (size_m - pos >= 2 && data_m[pos] == '/' && data_m[pos + 1] == '/') {
+        pos += 2;
+        size_t const end = pos + avx2_find_any_of(data_m + pos, size_m - pos, "/?#");
+        size_t host_begin = pos;
+        for (size_t i = end; i > pos; --i) {
+            if (data_m[i - 1] == '@') {
+                url.userinfo = {data_m + pos, i - 1 - pos};
+                host_begin = i;
+                break;
+            }
+        }
+        size_t host_end = end;
+        for (size_t i = end; i > host_begin && data_m[i - 1] != ']'; --i) {
+            if (data_m[i - 1] == ':') {
+                url.port = {data_m + i, end - i};
+                host_end = i - 1;
+                break;
+            }
+        }
+        url.host = {data_m + host_begin, host_end - host_begin};
+        pos = end;
+    }
+    size_t const path_end = pos + avx2_find_any_of(data_m + pos, size_m - pos, "?#");
+    url.path = {data_m + pos, path_end - pos};
+    pos = path_end;
+    if (pos < size_m && data_m[pos] == '?') {
+        size_t const query_end = pos + 1 + avx2_find_char(data_m + pos + 1, size_m - pos - 1, '#');
+        url.query = {data_m + pos + 1, query_end - pos - 1};
+        pos = query_end;
+    }
+    if (pos < size_m) {
+        url.fragment = {data_m + pos + 1, size_m - pos - 1};
+    }
+    return url;
+}
+
+int64_t my_str_avx_view::to_int64() const {
+    bool const negative = size_m > 0 && data_m[0] == '-';
+    size_t const sign = (size_m > 0 && (data_m[0] == '-' || data_m[0] == '+')) ? 1 : 0;
+    uint64_t magnitude = 0;
+    bool overflow = false;
+    if (size_m == sign || !avx2_parse_uint(data_m + sign, size_m - sign, magnitude, overflow)) {
+        throw std::invalid_argument("my_str_avx_view::to_int64");
+    }
+    uint64_t const limit = negative ? uint64_t(INT64_MAX) + 1 : uint64_t(INT64_MAX);
+    if (overflow || magnitude > limit) {
+        throw std::out_of_range("my_str_avx_view::to_int64");
+    }
+    return negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+}
+
+uint64_t my_str_avx_view::to_uint64() const {
+    size_t const sign = (size_m > 0 && data_m[0] == '+') ? 1 : 0;
+    uint64_t value = 0;
+    bool overflow = false;
+    if (size_m == sign || !avx2_parse_uint(data_m + sign, size_m - sign, value, overflow)) {
+        throw std::invalid_argument("my_str_avx_view::to_uint64");
+    }
+    if (overflow) {
+        throw std::out_of_range("my_str_avx_view::to_uint64");
+    }
+    return value;
+}
+
+double my_str_avx_view::to_double() const {
+    double value = 0;
+    if (parse_double_fast(data_m, size_m, avx2_parse_uint, value)) {
+        return value;
+    }
+    const char* begin = data_m;
+    const char* const end = data_m + size_m;
+    if (begin != end && *begin == '+' && end - begin > 1 && begin[1] != '-') {
+        ++begin;
+    }
+    std::from_chars_result const result = std::from_chars(begin, end, value);
+    if (result.ec == std::errc::invalid_argument || result.ptr != end) {
+        throw std::invalid_argument("my_str_avx_view::to_double");
+    }
+    if (result.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range("my_str_avx_view::to_double");
+    }
+    return value;
+}
+
+void my_str_avx_view::json_index(std::vector<size_t>& out) const {
+    if (!avx2_json_index(data_m, size_m, out)) {
+        throw std::invalid_argument("my_str_avx_view::json_index: unterminated string");
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, my_str_avx_view view) {
+    stream.write(view.data(), static_cast<std::streamsize>(view.size()));
+    return stream;
+}
+
+bool operator==(my_str_avx_view view1, my_str_avx_view view2) {
+    return view1.size() == view2.size() && avx2_equal(view1.data(), view2.data(), view1.size());
+}
+
+bool operator!=(my_str_avx_view view1, my_str_avx_view view2) {
+    return !(view1 == view2);
+}
+
+//! Той самий порядок, що й у my_str_avx: спершу за довжиною, тоді за першою
+//! відмінною літерою, яку шукає SIMD-порівняння.
+bool operator<(my_str_avx_view view1, my_str_avx_view view2) {
+    if (view1.size() != view2.size()) {
+        return view1.size() < view2.size();
+    }
+    size_t const pos = avx2_mismatch(view1.data(), view2.data(), view1.size());
+    return pos < view1.size() && view1.data()[pos] < view2.data()[pos];
+}
+
+bool operator>(my_str_avx_view view1, my_str_avx_view view2) {
+    return view2 < view1;
+}
+
+bool operator<=(my_str_avx_view view1, my_str_avx_view view2) {
+    return !(view2 < view1);
+}
+
+bool operator>=(my_str_avx_view view1, my_str_avx_view view2) {
+    return !(view1 < view2);
+}
+
+my_str_avx_lines::iterator::iterator(const char* data, size_t size, size_t pos)
+: data_m(data), size_m(size), pos_m(pos), next_m(pos), block_m(pos), mask_m(0) {
+    if (pos_m < size_m) {
+        mask_m = avx2_newline_mask(data_m, size_m, block_m);
+        load_line();
+    }
+}
+
+//! наступний '\n' після вже знайдених, або size_m
+size_t my_str_avx_lines::iterator::next_newline() {
+    while (mask_m == 0) {
+        block_m += line_block;
+        if (block_m >= size_m) {
+            return size_m;
+        }
+        mask_m = avx2_newline_mask(data_m, size_m, block_m);
+    }
+    size_t const pos = block_m + __builtin_ctzll(mask_m);
+    mask_m &= mask_m - 1;
+    return pos;
+}
+
+void my_str_avx_lines::iterator::load_line() {
+    size_t const newline = next_newline();
+    size_t end = newline;
+    if (newline < size_m) {
+        next_m = newline + 1;
+        if (end > pos_m && data_m[end - 1] == '\r') {
+            --end;
+        }
+    } else {
+        next_m = size_m;
+    }
+    line_m = my_str_avx_view(data_m + pos_m, end - pos_m);
+}
+
+my_str_avx_lines::iterator& my_str_avx_lines::iterator::operator++() {
+    pos_m = next_m;
+    if (pos_m < size_m) {
+        load_line();
+    }
+    return *this;
+}
+
+my_str_avx_lines::iterator my_str_avx_lines::iterator::operator++(int) {
+    iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+my_str_avx_lines::iterator my_str_avx_lines::begin() const {
+    return iterator(text_m.data(), text_m.size(), 0);
+}
+
+my_str_avx_lines::iterator my_str_avx_lines::end() const {
+    return iterator(text_m.data(), text_m.size(), text_m.size());
+}
+
+my_str_avx_csv::iterator::iterator(const char* data, size_t size, char delimiter, size_t pos)
+: data_m(data), size_m(size), delimiter_m(delimiter), pos_m(pos), next_m(pos), block_m(pos), mask_m(0), in_quotes_m(0) {
+    if (pos_m < size_m) {
+        load_block();
+        load_row();
+    }
+}
+
+//! роздільники блоку block_m поза лапками; стан лапок переноситься на наступний блок
+void my_str_avx_csv::iterator::load_block() {
+    uint64_t quote = 0;
+    uint64_t separator = 0;
+    avx2_csv_masks(data_m, size_m, block_m, delimiter_m, quote, separator);
+    uint64_t const in_quotes = avx2_prefix_xor(quote) ^ in_quotes_m;
+    in_quotes_m = static_cast<uint64_t>(static_cast<int64_t>(in_quotes) >> 63);
+    mask_m = separator & ~in_quotes;
+}
+
+//! наступний роздільник поля чи запису після вже знайдених, або size_m
+size_t my_str_avx_csv::iterator::next_separator() {
+    while (mask_m == 0) {
+        block_m += 64;
+        if (block_m >= size_m) {
+            return size_m;
+        }
+        load_block();
+    }
+    size_t const pos = block_m + __builtin_ctzll(mask_m);
+    mask_m &= mask_m - 1;
+    return pos;
+}
+
+void my_str_avx_csv::iterator::load_row() {
+    fields_m.clear();
+    size_t start = pos_m;
+    for (;;) {
+        size_t const separator = next_separator();
+        bool const last = separator == size_m || data_m[separator] == '\n';
+        size_t end = separator;
+        if (last && end > start && data_m[end - 1] == '\r') {
+            --end;
+        }
+        if (end - start >= 2 && data_m[start] == '"' && data_m[end - 1] == '"') {
+            fields_m.emplace_back(data_m + start + 1, end - start - 2);
+        } else {
+            fields_m.emplace_back(data_m + start, end - start);
+        }
+        if (last) {
+            next_m = separator < size_m ? separator + 1 : size_m;
+            return;
+        }
+        start = separator + 1;
+    }
+}
+
+my_str_avx_csv::iterator& my_str_avx_csv::iterator::operator++() {
+    pos_m = next_m;
+    if (pos_m < size_m) {
+        load_row();
+    }
+    return *this;
+}
+
+my_str_avx_csv::iterator my_str_avx_csv::iterator::operator++(int) {
+    iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+my_str_avx_csv::iterator my_str_avx_csv::begin() const {
+    return iterator(text_m.data(), text_m.size(), delimiter_m, 0);
+}
+
+my_str_avx_csv::iterator my_str_avx_csv::end() const {
+    return iterator(text_m.data(), text_m.size(), delimiter_m, text_m.size());
+}
+
+my_str_avx_code_points::iterator::iterator(const char* data, size_t size, size_t pos)
+: data_m(data), size_m(size), pos_m(pos), next_m(pos), code_point_m(0) {
+    if (pos_m < size_m) {
+        decode();
+    }
+}
+
+//! Декодує код з pos_m; неправильний чи обірваний -- U+FFFD довжиною в байт.
+void my_str_avx_code_points::iterator::decode() {
+    char32_t code_point = 0;
+    size_t const length = utf8_decode(data_m + pos_m, size_m - pos_m, code_point);
+    if (length == 0) {
+        code_point_m = 0xFFFD;
+        next_m = pos_m + 1;
+        return;
+    }
+    code_point_m = code_point;
+    next_m = pos_m + length;
+}
+
+my_str_avx_code_points::iterator& my_str_avx_code_points::iterator::operator++() {
+    pos_m = next_m;
+    if (pos_m < size_m) {
+        decode();
+    }
+    return *this;
+}
+
+my_str_avx_code_points::iterator my_str_avx_code_points::iterator::operator++(int) {
+    iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+my_str_avx_code_points::iterator my_str_avx_code_points::begin() const {
+    return iterator(text_m.data(), text_m.size(), 0);
+}
+
+my_str_avx_code_points::iterator my_str_avx_code_points::end() const {
+    return iterator(text_m.data(), text_m.size(), text_m.size());
+}
+
 #else
 
 #error "AVX2 not supported by the compiler"
@@ -7,14 +7,248 @@
 #include <cstddef>
 #include <string>
 #include <iostream>
+#include <cstdint>
+#include <iterator>
+#include <initializer_list>
+#include <vector>
 #include <arm_neon.h>
 
+class my_str_simd;
+struct my_str_simd_url;
+
+//! Невласницький погляд на послідовність байт: частину my_str_simd, C-стрічку
+//! чи відображений у пам'ять файл (див. mapped_file.h). Нічого не копіює і не
+//! виділяє, тож дані мусять жити довше за view. '\0' в кінці не гарантується.
+class my_str_simd_view {
+private:
+    const char* data_m;
+    size_t size_m;
+
+public:
+    my_str_simd_view() noexcept;
+    my_str_simd_view(const char* data, size_t size) noexcept;
+    my_str_simd_view(const char* cstr);
+    my_str_simd_view(const my_str_simd& str) noexcept;
+
+    const char* data() const { return data_m; }
+    size_t size() const { return size_m; }
+    bool empty() const { return size_m == 0; }
+
+    const char& operator[](size_t idx) const;
+    const char& at(size_t idx) const;
+    //! Підстрічка без копіювання -- теж view у ті самі дані
+    my_str_simd_view substr(size_t begin, size_t size) const;
+
+    static constexpr size_t not_found = -1;
+    size_t find(char c, size_t idx = 0) const;
+    size_t find(my_str_simd_view str, size_t idx = 0) const;
+    size_t find(const std::string& str, size_t idx = 0) const;
+    size_t find(const char* cstr, size_t idx = 0) const;
+
+    //! Ділить view на поля між роздільниками delim і записує їх в out.
+    //! out спершу очищується, тож його місткість перевикористовується між
+    //! викликами. n роздільників дають n + 1 полів, порожні поля зберігаються.
+    void split(char delim, std::vector<my_str_simd_view>& out) const;
+    //! Те саме, але роздільником є будь-яка літера з charset
+    void split_any(my_str_simd_view charset, std::vector<my_str_simd_view>& out) const;
+
+    //! Без ASCII-пробілів (' ', '\t', '\n', '\v', '\f', '\r') на початку (ltrim),
+    //! у кінці (rtrim) чи з обох боків (trim) -- view у ті самі дані
+    my_str_simd_view ltrim() const;
+    my_str_simd_view rtrim() const;
+    my_str_simd_view trim() const;
+
+    //! Див. my_str_simd::is_valid_utf8
+    bool is_valid_utf8() const;
+    //! Див. my_str_simd::utf8_length та my_str_simd::utf8_offset
+    size_t utf8_length() const;
+    size_t utf8_offset(size_t n) const;
+    //! Див. my_str_simd::to_utf16 та my_str_simd::to_utf32
+    std::u16string to_utf16() const;
+    std::u32string to_utf32() const;
+    size_t to_utf16(std::u16string& out) const;
+    size_t to_utf32(std::u32string& out) const;
+    //! Див. my_str_simd::parse_url
+    my_str_simd_url parse_url() const;
+    //! Див. my_str_simd::to_int64 та my_str_simd::to_uint64
+    int64_t to_int64() const;
+    uint64_t to_uint64() const;
+    //! Див. my_str_simd::to_double
+    double to_double() const;
+    //! Див. my_str_simd::json_index
+    void json_index(std::vector<size_t>& out) const;
+};
+
+//! Рядки тексту (буфера, my_str_simd чи mapped_file) як view, без жодної
+//! алокації на рядок. Кінці рядків шукає SIMD-порівняння з '\n' блоками, а
+//! маска знайдених '\n' блоку обходиться побітово, тож кожен байт
+//! переглядається один раз. "\r\n" теж вважається кінцем рядка; останній
+//! рядок без '\n' повертається як є. Приклад:
+//!     for (my_str_simd_view line : my_str_simd_lines(file.view<my_str_simd_view>())) { ... }
+class my_str_simd_lines {
+public:
+    class iterator {
+    private:
+        const char* data_m;
+        size_t size_m;
+        size_t pos_m;    // початок поточного рядка
+        size_t next_m;   // початок наступного рядка
+        size_t block_m;  // початок блоку, якому відповідає mask_m
+        uint64_t mask_m; // ще не використані '\n' цього блоку
+        my_str_simd_view line_m;
+
+        iterator(const char* data, size_t size, size_t pos);
+        size_t next_newline();
+        void load_line();
+        friend class my_str_simd_lines;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = my_str_simd_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const my_str_simd_view*;
+        using reference = const my_str_simd_view&;
+
+        reference operator*() const { return line_m; }
+        pointer operator->() const { return &line_m; }
+        iterator& operator++();
+        iterator operator++(int);
+        //! Зсув поточного рядка від початку тексту
+        size_t offset() const { return pos_m; }
+
+        bool operator==(const iterator& other) const { return pos_m == other.pos_m; }
+        bool operator!=(const iterator& other) const { return pos_m != other.pos_m; }
+    };
+
+    explicit my_str_simd_lines(my_str_simd_view text) : text_m(text) {}
+    iterator begin() const;
+    iterator end() const;
+
+private:
+    my_str_simd_view text_m;
+};
+
+//! Записи CSV/TSV тексту як рядки полів-view, без алокації на поле: вектор
+//! полів перевикористовується від запису до запису. Лапки, роздільники та '\n'
+//! шукає SIMD-порівняння блоками по 64 байти, а області в лапках дає
+//! префіксний XOR маски лапок, тож роздільники й '\n' у лапках не ділять поле.
+//! Поле в лапках повертається без зовнішніх лапок, подвоєні "" у ньому
+//! лишаються як є; незакриті лапки тягнуться до кінця тексту. "\r\n" теж
+//! кінець запису. Приклад:
+//!     for (const auto& row : my_str_simd_csv(file.view<my_str_simd_view>(), '\t')) { ... row[0] ... }
+class my_str_simd_csv {
+public:
+    class iterator {
+    private:
+        const char* data_m;
+        size_t size_m;
+        char delimiter_m;
+        size_t pos_m;         // початок поточного запису
+        size_t next_m;        // початок наступного запису
+        size_t block_m;       // початок блоку, якому відповідає mask_m
+        uint64_t mask_m;      // ще не використані роздільники цього блоку поза лапками
+        uint64_t in_quotes_m; // усі одиниці, якщо попередній блок закінчився в лапках
+        std::vector<my_str_simd_view> fields_m;
+
+        iterator(const char* data, size_t size, char delimiter, size_t pos);
+        void load_block();
+        size_t next_separator();
+        void load_row();
+        friend class my_str_simd_csv;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::vector<my_str_simd_view>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::vector<my_str_simd_view>*;
+        using reference = const std::vector<my_str_simd_view>&;
+
+        reference operator*() const { return fields_m; }
+        pointer operator->() const { return &fields_m; }
+        iterator& operator++();
+        iterator operator++(int);
+        //! Зсув поточного запису від початку тексту
+        size_t offset() const { return pos_m; }
+
+        bool operator==(const iterator& other) const { return pos_m == other.pos_m; }
+        bool operator!=(const iterator& other) const { return pos_m != other.pos_m; }
+    };
+
+    explicit my_str_simd_csv(my_str_simd_view text, char delimiter = ',') : text_m(text), delimiter_m(delimiter) {}
+    iterator begin() const;
+    iterator end() const;
+
+private:
+    my_str_simd_view text_m;
+    char delimiter_m;
+};
+
+//! Коди UTF-8 тексту як char32_t, без копіювання. Неправильний чи обірваний
+//! байт повертається як U+FFFD і пропускається сам; offset() -- зсув коду
+//! в байтах. Приклад:
+//!     for (char32_t c : my_str_simd_code_points(text)) { ... }
+class my_str_simd_code_points {
+public:
+    class iterator {
+    private:
+        const char* data_m;
+        size_t size_m;
+        size_t pos_m;  // початок поточного коду
+        size_t next_m; // початок наступного коду
+        char32_t code_point_m;
+
+        iterator(const char* data, size_t size, size_t pos);
+        void decode();
+        friend class my_str_simd_code_points;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = char32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char32_t*;
+        using reference = char32_t;
+
+        char32_t operator*() const { return code_point_m; }
+        iterator& operator++();
+        iterator operator++(int);
+        //! Зсув поточного коду від початку тексту в байтах
+        size_t offset() const { return pos_m; }
+
+        bool operator==(const iterator& other) const { return pos_m == other.pos_m; }
+        bool operator!=(const iterator& other) const { return pos_m != other.pos_m; }
+    };
+
+    explicit my_str_simd_code_points(my_str_simd_view text) : text_m(text) {}
+    iterator begin() const;
+    iterator end() const;
+
+private:
+    my_str_simd_view text_m;
+};
+
+//! Складники URL (RFC 3986) як view у вихідний текст, без копіювання й
+//! декодування: scheme://userinfo@host:port/path?query#fragment. Відсутні
+//! складники -- порожні view; IPv6-хост лишається в дужках.
+struct my_str_simd_url {
+    my_str_simd_view scheme;
+    my_str_simd_view userinfo;
+    my_str_simd_view host;
+    my_str_simd_view port;
+    my_str_simd_view path;
+    my_str_simd_view query;
+    my_str_simd_view fragment;
+};
+
 class my_str_simd {
 private:
     char* data_m;
     size_t capacity_m;
     size_t size_m;
 
+    static my_str_simd_view piece_view(my_str_simd_view piece) { return piece; }
+    static my_str_simd_view piece_view(const std::string& piece) { return {piece.data(), piece.size()}; }
+    static my_str_simd_view piece_view(const char* piece) { return my_str_simd_view(piece); }
+
 public:
     //! Створює стрічку із size копій літери initial
     //! capacity_m встановлює рівним або більшим за size
@@ -30,6 +264,16 @@ public:
     //! Копіює стрічку С++, вимоги до capacity_m -- ті ж, що вище
     my_str_simd(const std::string& str);
 
+    //! Копіює вміст view; місткість -- рівно під дані
+    explicit my_str_simd(const my_str_simd_view& view);
+
+    //! Тег конструктора, що перевіряє UTF-8: my_str_simd s(bytes, my_str_simd::validate_utf8)
+    struct validate_utf8_t {};
+    static constexpr validate_utf8_t validate_utf8{};
+    //! Копіює view, якщо це коректний UTF-8.
+    //! Обробка помилок: інакше кидає std::invalid_argument
+    my_str_simd(const my_str_simd_view& view, validate_utf8_t);
+
     //!оператор присвоєння
     my_str_simd& operator=(const my_str_simd& mystr);
 
@@ -65,14 +309,169 @@ public:
     //! Аналогічна оптимізація для C-стрічок
     void insert(size_t idx, const char* cstr);
     void append(const my_str_simd& str);
-    void append(char c);
+    //! Швидкий шлях для дописування однієї літери: одна перевірка місткості,
+    //! без зсуву хвоста; місткість росте геометрично, тож в середньому O(1).
+    void append(char c) {
+        if (size_m + 2 > capacity_m) {
+            reserve(2 * capacity_m + 2);
+        }
+        data_m[size_m] = c;
+        ++size_m;
+        data_m[size_m] = '\0';
+    }
     void append(const char* cstr);
+    //! Дописує len байт з cstr без виклику strlen (cstr може вказувати
+    //! всередину самої стрічки).
+    void append(const char* cstr, size_t len);
     void erase(size_t begin, size_t size);
     my_str_simd substr(size_t begin, size_t size) const;
     static constexpr size_t not_found = -1;
     size_t find(char c, size_t idx = 0) const;
     size_t find(const std::string& str, size_t idx = 0) const;
     size_t find(const char* cstr, size_t idx = 0) const;
+    //! Поля між роздільниками як view у цю стрічку (див. my_str_simd_view::split);
+    //! вони дійсні, доки стрічку не змінено
+    void split(char delim, std::vector<my_str_simd_view>& out) const;
+    void split_any(my_str_simd_view charset, std::vector<my_str_simd_view>& out) const;
+
+    //! Склеює pieces через sep. Спершу рахує сумарну довжину, тож результат
+    //! алокується один раз, а кожен шматок копіюється одним векторним append.
+    //! Елементи pieces -- my_str_simd, my_str_simd_view, const char* або std::string.
+    template <typename Range>
+    static my_str_simd join(const Range& pieces, my_str_simd_view sep = my_str_simd_view());
+    //! join без роздільника, замість ланцюжка a + b + c: my_str_simd::concat({a, b, "c"})
+    static my_str_simd concat(std::initializer_list<my_str_simd_view> pieces);
+
+    //! Регістр лише ASCII-літер, без локалі; решта байтів (зокрема UTF-8)
+    //! лишається як є. to_upper/to_lower змінюють стрічку на місці, *_copy
+    //! повертають нову з місткістю рівно під дані.
+    void to_upper();
+    void to_lower();
+    my_str_simd to_upper_copy() const;
+    my_str_simd to_lower_copy() const;
+
+    //! Обрізає ASCII-пробіли на місці; *_copy повертають нову стрічку з
+    //! місткістю рівно під дані, а my_str_simd_view(str).trim() -- view без копіювання
+    void ltrim();
+    void rtrim();
+    void trim();
+    my_str_simd ltrim_copy() const;
+    my_str_simd rtrim_copy() const;
+    my_str_simd trim_copy() const;
+
+    //! Нормалізує пробіли: кожна серія ASCII-пробілів стає одним ' ', на
+    //! початку й у кінці пробілів не лишається ("  a \t\n b " -> "a b").
+    //! Пробіли класифікуються векторно, а непотрібні байти викидає left-pack
+    //! за таблицею перестановок. collapse_whitespace_copy повертає нову стрічку
+    void collapse_whitespace();
+    my_str_simd collapse_whitespace_copy() const;
+
+    //! Видаляє на місці всі байти c (remove) чи будь-які байти з charset
+    //! (remove_any) за один лінійний прохід: маска блоку відкидає їх
+    //! left-pack'ом, а не erase з переносом хвоста на кожен байт. Набір
+    //! довільного розміру перевіряється двома векторними таблицями
+    void remove(char c);
+    void remove_any(my_str_simd_view charset);
+
+    //! Замінює [pos, pos + len) на str; len обрізається до кінця стрічки.
+    //! Обробка помилок: якщо pos > size_m -- кидає std::out_of_range
+    void replace(size_t pos, size_t len, my_str_simd_view str);
+    //! Замінює всі входження from (без перекриттів, зліва направо) на to і
+    //! повертає їх кількість. Усі входження шукаються одним проходом, тож
+    //! результат алокується не більше одного разу, а незмінені проміжки
+    //! копіюються векторно. Порожній from нічого не замінює.
+    size_t replace_all(my_str_simd_view from, my_str_simd_view to);
+
+    //! Замінює кожен байт c на table[c] (як tr). Якщо таблиця змінює лише
+    //! кілька байтів, блок порівнюється з кожним із них; інакше -- векторний
+    //! пошук у всіх 256 записах.
+    void translate(const uint8_t table[256]);
+
+    //! Чи є вміст коректним UTF-8 (без надлишкових кодувань, сурогатів і
+    //! кодів понад U+10FFFF). ASCII перевіряється по 64 байти за крок.
+    bool is_valid_utf8() const;
+    //! Кількість кодів UTF-8 (а не байтів, як size()): байти, що не є продовженнями
+    size_t utf8_length() const;
+    //! Зсув у байтах n-го (з нуля) коду; utf8_offset(utf8_length()) == size().
+    //! Обрізання до N кодів: substr(0, utf8_offset(N)).
+    //! Обробка помилок: якщо кодів менше за n -- кидає std::out_of_range
+    size_t utf8_offset(size_t n) const;
+    //! Перекодування в UTF-16 / UTF-32: ASCII-ділянки розширюються векторно
+    //! цілими блоками, решта декодується по одному коду.
+    //! Обробка помилок: якщо вміст -- не коректний UTF-8, кидає std::invalid_argument
+    std::u16string to_utf16() const;
+    std::u32string to_utf32() const;
+    //! Те саме без винятків: повертає not_found, або зсув першої неправильної
+    //! послідовності; out тоді містить перекодований до неї префікс
+    size_t to_utf16(std::u16string& out) const;
+    size_t to_utf32(std::u32string& out) const;
+    //! Рядок UTF-8 з UTF-16 / UTF-32; пам'ять виділяється один раз.
+    //! Обробка помилок: непарний сурогат чи код понад U+10FFFF -- кидає std::invalid_argument
+    static my_str_simd from_utf16(const char16_t* src, size_t size);
+    static my_str_simd from_utf16(const std::u16string& src);
+    static my_str_simd from_utf32(const char32_t* src, size_t size);
+    static my_str_simd from_utf32(const std::u32string& src);
+
+    //! Режим base64_decode: strict -- лише канонічний RFC 4648 (довжина кратна 4,
+    //! '=' лише в кінці, зайві біти останньої літери нульові); lenient -- пропускає
+    //! ASCII-пробіли (перенесення рядків MIME/PEM) і дозволяє відсутні '='
+    enum class base64_mode { strict, lenient };
+    //! base64 (RFC 4648, з '='); результат виділяється один раз точного розміру
+    my_str_simd base64_encode() const;
+    //! Декодує base64; векторний шлях перевіряє і перетворює цілий блок літер за раз.
+    //! Обробка помилок: літера поза алфавітом, обірвана група чи (strict) неканонічний
+    //! вміст -- кидає std::invalid_argument
+    my_str_simd base64_decode(base64_mode mode = base64_mode::strict) const;
+    //! Байти як шістнадцяткові цифри (нижній регістр), по дві на байт
+    my_str_simd to_hex() const;
+    //! Байти з пар шістнадцяткових цифр будь-якого регістру.
+    //! Обробка помилок: непарна кількість чи нецифра -- кидає std::invalid_argument
+    static my_str_simd from_hex(my_str_simd_view hex);
+
+    //! Екранування для виводу: рядок JSON (без зовнішніх лапок; \" \\ \n \r \t \b \f,
+    //! решта керівних байтів -- \u00XX), текст чи атрибут HTML (&amp; &lt; &gt;
+    //! &quot; &#39;) та поле CSV (у лапках з подвоєними '"', якщо містить , " \n чи \r;
+    //! інакше без змін). Перша особлива літера шукається SIMD-маскою, чисті
+    //! ділянки копіюються цілими.
+    my_str_simd escape_json() const;
+    my_str_simd escape_html() const;
+    my_str_simd escape_csv() const;
+    //! Розкодовує %XX (і '+' як пробіл, якщо plus_as_space); '%' і '+' шукає
+    //! SIMD-порівняння, чисті ділянки копіюються цілими.
+    //! Обробка помилок: '%' без двох шістнадцяткових цифр -- кидає std::invalid_argument
+    my_str_simd url_decode(bool plus_as_space = true) const;
+    //! Ділить URL на складники (див. my_str_simd_url); роздільники ":/?#" шукає одна
+    //! векторна маска набору. View дійсні, доки рядок живий і не змінюється
+    my_str_simd_url parse_url() const;
+    //! Ціле число з усього вмісту: необов'язковий знак ('-' лише для to_int64) і
+    //! десяткові цифри, без пробілів. Цифри перевіряються й зводяться векторно,
+    //! по 16 за крок, без тимчасових std::string.
+    //! Обробка помилок: порожньо чи нецифра -- кидає std::invalid_argument,
+    //! значення поза типом -- std::out_of_range
+    int64_t to_int64() const;
+    uint64_t to_uint64() const;
+    //! Дописує десятковий запис числа (по дві цифри за ділення, без std::to_string)
+    void append_int(int64_t value);
+    void append_uint(uint64_t value);
+    //! Рядок з десятковим записом числа
+    static my_str_simd from_int(int64_t value);
+    static my_str_simd from_uint(uint64_t value);
+    //! Число з рухомою комою з усього вмісту, без пробілів. Короткі десяткові
+    //! записи (до 19 значущих цифр, порядок у межах точних степенів 10) зводяться
+    //! векторним розбором цифр і одним множенням; решта (і "inf"/"nan") -- через
+    //! std::from_chars, що заокруглює правильно.
+    //! Обробка помилок: не число -- кидає std::invalid_argument, поза double -- std::out_of_range
+    double to_double() const;
+    //! Дописує найкоротший запис, що читається назад у те саме значення (std::to_chars)
+    void append_double(double value);
+    static my_str_simd from_double(double value);
+    //! Перший етап розбору JSON: у out (пам'ять перевикористовується) -- позиції
+    //! структурних літер {}[]:, поза рядками та лапок, що відкривають і закривають
+    //! рядки, у порядку тексту; дерево не будується. Лапки, '\\' і структурні
+    //! літери класифікуються векторно по 64 байти, екрановані лапки відкидає
+    //! бітова арифметика, а межі рядків дає префіксний XOR маски лапок.
+    //! Обробка помилок: незакритий рядок -- кидає std::invalid_argument
+    void json_index(std::vector<size_t>& out) const;
 
 
     my_str_simd& operator+=(char chr);
@@ -118,10 +517,54 @@ bool operator<=(const my_str_simd& str1, const char* cstr2);
 
 my_str_simd operator+(const my_str_simd& mystr, const my_str_simd& mystr2);
 my_str_simd operator+(const my_str_simd& mystr, const char* mystr2);
+my_str_simd operator+(const char* mystr, const my_str_simd& mystr2);
 my_str_simd operator+(const my_str_simd& mystr2, char chr);
 my_str_simd operator+(char chr, const my_str_simd& mystr2);
 
+//! Тимчасовий операнд віддає свій буфер результату: лівий дописується,
+//! у правий вставляється початок, тож std::move(a) + b не копіює a.
+my_str_simd operator+(my_str_simd&& mystr, const my_str_simd& mystr2);
+my_str_simd operator+(my_str_simd&& mystr, my_str_simd&& mystr2);
+my_str_simd operator+(my_str_simd&& mystr, const char* mystr2);
+my_str_simd operator+(my_str_simd&& mystr, char chr);
+my_str_simd operator+(const my_str_simd& mystr, my_str_simd&& mystr2);
+my_str_simd operator+(const char* mystr, my_str_simd&& mystr2);
+my_str_simd operator+(char chr, my_str_simd&& mystr2);
+
 my_str_simd operator*(const my_str_simd& str1, int count);
 my_str_simd operator*(int count, const my_str_simd& str1);
 
+template <typename Range>
+my_str_simd my_str_simd::join(const Range& pieces, my_str_simd_view sep) {
+    size_t total = 0;
+    size_t count = 0;
+    for (const auto& piece : pieces) {
+        total += piece_view(piece).size();
+        ++count;
+    }
+    if (count > 1) {
+        total += sep.size() * (count - 1);
+    }
+    my_str_simd result;
+    result.reserve(total + 1);
+    bool first = true;
+    for (const auto& piece : pieces) {
+        if (!first) {
+            result.append(sep.data(), sep.size());
+        }
+        first = false;
+        my_str_simd_view const view = piece_view(piece);
+        result.append(view.data(), view.size());
+    }
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& stream, my_str_simd_view view);
+bool operator==(my_str_simd_view view1, my_str_simd_view view2);
+bool operator!=(my_str_simd_view view1, my_str_simd_view view2);
+bool operator<(my_str_simd_view view1, my_str_simd_view view2);
+bool operator>(my_str_simd_view view1, my_str_simd_view view2);
+bool operator<=(my_str_simd_view view1, my_str_simd_view view2);
+bool operator>=(my_str_simd_view view1, my_str_simd_view view2);
+
 #endif
@@ -1,6 +1,7 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
 #include "mystring.hpp"
+#include <utility>
 int main() {
     std::cout << "Testing my_str_t class functions..." << std::endl;
     try {
@@ -511,5 +512,24 @@ int main() {
     } else {
         std::cerr << "Test failed: str1 > cppstr1 (my_str_t <= std::string)" << std::endl;
     }
+    // operator+ з тимчасовими операндами: результат забирає їхній буфер
+    {
+        my_str_t head("head of a long template fragment");
+        const char* head_buffer = head.c_str();
+        my_str_t moved_left = std::move(head) + my_str_t("+") + "tail" + '!';
+        my_str_t tail("tail of another long fragment");
+        const char* tail_buffer = tail.c_str();
+        my_str_t prefix("x");
+        my_str_t moved_right = "<" + ('[' + (prefix + std::move(tail)));
+        my_str_t self("ab");
+        my_str_t doubled = self + std::move(self);
+        if (moved_left == "head of a long template fragment+tail!" && moved_left.c_str() == head_buffer
+            && moved_right == "<[xtail of another long fragment" && moved_right.c_str() == tail_buffer
+            && doubled == "abab") {
+            std::cout << "Test passed: rvalue operator+ reuses the operand buffer" << std::endl;
+        } else {
+            std::cerr << "Test failed: rvalue operator+ reuses the operand buffer" << std::endl;
+        }
+    }
     return 0;
 }
\ No newline at end of file
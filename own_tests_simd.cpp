@@ -1,4 +1,12 @@
 #include "mystring_simd.h"
+#include <utility>
+#include "mapped_file.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <vector>
+#include <limits>
 int main() {
     std::cout << "Testing my_str_t class functions..." << std::endl;
     try {
@@ -168,6 +176,45 @@ int main() {
         std::cout << "Test passed: append_test3 == 'Welcome to C++ World!'." << std::endl;
     }
 
+    // Дописування по одній літері та блоком відомої довжини
+    my_str_simd append_fast;
+    std::string append_expected;
+    for (int i = 0; i < 1000; ++i) {
+        append_fast.append(static_cast<char>('a' + i % 26));
+        append_expected += static_cast<char>('a' + i % 26);
+    }
+    if (append_fast == append_expected.c_str()) {
+        std::cout << "Test passed: 1000 x append(char)" << std::endl;
+    } else {
+        std::cerr << "Test failed: 1000 x append(char)" << std::endl;
+    }
+
+    my_str_simd append_bulk("key=");
+    append_bulk.append("value;garbage", 5);
+    if (append_bulk == "key=value") {
+        std::cout << "Test passed: append(cstr, len) == 'key=value'" << std::endl;
+    } else {
+        std::cerr << "Test failed: append(cstr, len) expected 'key=value' but got '" << append_bulk << "'" << std::endl;
+    }
+
+    my_str_simd append_self("0123456789abcdefghijklmnopqrstuvwxyz");
+    append_self.shrink_to_fit();
+    append_self.append(append_self.c_str() + 10, 26);
+    if (append_self == "0123456789abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz") {
+        std::cout << "Test passed: append from own buffer survives reallocation" << std::endl;
+    } else {
+        std::cerr << "Test failed: append from own buffer got '" << append_self << "'" << std::endl;
+    }
+
+    my_str_simd append_moved("moved");
+    my_str_simd append_target(std::move(append_moved));
+    append_moved.append('!');
+    if (append_moved == "!") {
+        std::cout << "Test passed: append(char) on moved-from string" << std::endl;
+    } else {
+        std::cerr << "Test failed: append(char) on moved-from string" << std::endl;
+    }
+
     str.insert(1, 'c'); // Вставляє 'c' на позицію 1
     std::cout << "After insert 'c' at index 1: " << str.c_str() << std::endl;
     str.erase(2, 2); // Видаляє 2 символи з позиції 2
@@ -378,6 +425,33 @@ int main() {
         } else {
             std::cerr << "Test failed: repeat_str1 *= 2 != 'abcabc'" << std::endl;
         }
+        // Повторення подвоєнням: порожня, одна літера, довга стрічка
+        my_str_simd repeat_one("x");
+        repeat_one *= 100;
+        if (repeat_one == my_str_simd(100, 'x') && repeat_one.capacity() == 101) {
+            std::cout << "Test passed: 'x' *= 100 fills 100 chars with exact capacity" << std::endl;
+        } else {
+            std::cerr << "Test failed: 'x' *= 100 != 100 x 'x'" << std::endl;
+        }
+
+        my_str_simd repeat_zero = my_str_simd("abc") * 0;
+        if (repeat_zero.size() == 0 && repeat_zero == "") {
+            std::cout << "Test passed: 'abc' * 0 is empty" << std::endl;
+        } else {
+            std::cerr << "Test failed: 'abc' * 0 is not empty" << std::endl;
+        }
+
+        std::string repeat_expected;
+        for (int i = 0; i < 37; ++i) {
+            repeat_expected += "0123456789abcdefghijk";
+        }
+        my_str_simd repeat_long = 37 * my_str_simd("0123456789abcdefghijk");
+        if (repeat_long == repeat_expected.c_str() && repeat_long.capacity() == repeat_expected.size() + 1) {
+            std::cout << "Test passed: 37 * long string matches std::string" << std::endl;
+        } else {
+            std::cerr << "Test failed: 37 * long string != expected" << std::endl;
+        }
+
         my_str_simd* test_obj = new my_str_simd("Test string");
         delete test_obj;
         test_obj = nullptr;
@@ -509,5 +583,852 @@ int main() {
     } else {
         std::cerr << "Test failed: str1 > cppstr1 (my_str_simd <= std::string)" << std::endl;
     }
+    // readline: '\n' забирається з потоку, останній рядок без '\n', кінець файлу
+    std::string long_line(100000, 'q');
+    std::istringstream readline_in("first line\n\nsecond\r\n" + long_line + "\nlast");
+    my_str_simd line;
+    std::vector<std::string> lines;
+    while (readline(readline_in, line)) {
+        lines.emplace_back(line.c_str(), line.size());
+    }
+    if (lines.size() == 5 && lines[0] == "first line" && lines[1].empty() && lines[2] == "second\r"
+        && lines[3] == long_line && lines[4] == "last") {
+        std::cout << "Test passed: readline splits lines and stops at EOF" << std::endl;
+    } else {
+        std::cerr << "Test failed: readline returned " << lines.size() << " lines" << std::endl;
+    }
+
+    // operator>>: слова, розділені будь-якими ASCII-пробілами
+    std::istringstream words_in("  alpha\tbeta \n\v gamma\r\ndelta");
+    my_str_simd word;
+    std::string words_joined;
+    int words_count = 0;
+    while (words_in >> word) {
+        words_joined += word.c_str();
+        words_joined += '|';
+        ++words_count;
+    }
+    if (words_count == 4 && words_joined == "alpha|beta|gamma|delta|") {
+        std::cout << "Test passed: operator>> reads whitespace-separated words" << std::endl;
+    } else {
+        std::cerr << "Test failed: operator>> got '" << words_joined << "'" << std::endl;
+    }
+    // Пошук підстрічки через межі SIMD-блоків і порівняння довгих стрічок
+    std::string haystack_src(200, '.');
+    haystack_src.replace(150, 6, "needle");
+    haystack_src.replace(40, 5, "needl");
+    my_str_simd haystack(haystack_src);
+    if (haystack.find("needle") == 150 && haystack.find("needle", 151) == my_str_simd::not_found
+        && haystack.find(std::string("needl")) == 40) {
+        std::cout << "Test passed: find(substring) across SIMD blocks" << std::endl;
+    } else {
+        std::cerr << "Test failed: find(substring) across SIMD blocks" << std::endl;
+    }
+    my_str_simd almost_equal(haystack_src);
+    almost_equal[77] = '!';
+    if (!(almost_equal == haystack) && almost_equal != haystack_src.c_str()) {
+        std::cout << "Test passed: == detects one differing byte in a long string" << std::endl;
+    } else {
+        std::cerr << "Test failed: == missed a differing byte in a long string" << std::endl;
+    }
+
+    // mapped_file + view: пошук і порівняння без копіювання в пам'ять
+    const char* mapped_path = "mapped_file_test.txt";
+    {
+        std::ofstream mapped_out(mapped_path, std::ios::binary);
+        mapped_out << "header line\n" << haystack_src << "\ntrailer";
+    }
+    {
+        mapped_file file(mapped_path);
+        my_str_simd_view text = file.view<my_str_simd_view>();
+        size_t const newline = text.find('\n');
+        my_str_simd_view header = text.substr(0, newline);
+        if (text.size() == 12 + haystack_src.size() + 8 && header == "header line"
+            && text.find("needle") == 12 + 150 && text.find("trailer") == text.size() - 7) {
+            std::cout << "Test passed: mapped_file view find/substr/==" << std::endl;
+        } else {
+            std::cerr << "Test failed: mapped_file view find/substr/==" << std::endl;
+        }
+        my_str_simd header_copy(header);
+        if (header_copy == "header line" && header_copy.capacity() == header.size() + 1
+            && my_str_simd_view(header_copy) == header && header < text && !(text < header)) {
+            std::cout << "Test passed: my_str_simd from view copies exactly once" << std::endl;
+        } else {
+            std::cerr << "Test failed: my_str_simd from view" << std::endl;
+        }
+    }
+    std::remove(mapped_path);
+    try {
+        mapped_file missing("no_such_file_for_mapped_file_test.txt");
+        std::cerr << "Test failed: mapping a missing file did not throw" << std::endl;
+    } catch (const std::system_error&) {
+        std::cout << "Test passed: mapping a missing file throws std::system_error" << std::endl;
+    }
+    // my_str_simd_lines: рядки як view, "\r\n" і останній рядок без '\n'
+    {
+        const char* lines_src = "a\r\nbb\n\nccc";
+        const char* expected_lines[] = {"a", "bb", "", "ccc"};
+        size_t const expected_offsets[] = {0, 3, 6, 7};
+        size_t count = 0;
+        bool lines_ok = true;
+        my_str_simd_lines lines(lines_src);
+        for (auto it = lines.begin(); it != lines.end(); ++it, ++count) {
+            if (count >= 4 || !(*it == expected_lines[count]) || it.offset() != expected_offsets[count]) {
+                lines_ok = false;
+            }
+        }
+        if (lines_ok && count == 4) {
+            std::cout << "Test passed: my_str_simd_lines splits on \\n and \\r\\n" << std::endl;
+        } else {
+            std::cerr << "Test failed: my_str_simd_lines splits on \\n and \\r\\n" << std::endl;
+        }
+    }
+    {
+        std::string long_text;
+        for (int i = 0; i < 300; ++i) {
+            long_text += std::string(i % 53, char('a' + i % 26));
+            long_text += (i % 7 == 0) ? "\n\n" : "\n";
+        }
+        long_text += "tail";
+        std::istringstream long_in(long_text);
+        std::vector<std::string> expected;
+        for (std::string line; std::getline(long_in, line);) {
+            expected.push_back(line);
+        }
+        std::vector<std::string> actual;
+        for (my_str_simd_view line : my_str_simd_lines(my_str_simd_view(long_text.data(), long_text.size()))) {
+            actual.push_back(std::string(line.data(), line.size()));
+        }
+        size_t empty_count = 0;
+        for (my_str_simd_view line : my_str_simd_lines("")) {
+            (void)line;
+            ++empty_count;
+        }
+        size_t single_count = 0;
+        for (my_str_simd_view line : my_str_simd_lines("a\n")) {
+            single_count += (line == "a") ? 1 : 100;
+        }
+        if (actual == expected && empty_count == 0 && single_count == 1) {
+            std::cout << "Test passed: my_str_simd_lines matches std::getline" << std::endl;
+        } else {
+            std::cerr << "Test failed: my_str_simd_lines matches std::getline" << std::endl;
+        }
+    }
+    // split / split_any: поля як view у вихідний вектор
+    {
+        std::vector<my_str_simd_view> fields;
+        my_str_simd row("a,,bc,");
+        row.split(',', fields);
+        if (fields.size() == 4 && fields[0] == "a" && fields[1] == "" && fields[2] == "bc"
+            && fields[3] == "" && fields[2].data() == row.c_str() + 3) {
+            std::cout << "Test passed: split keeps empty fields and points into the string" << std::endl;
+        } else {
+            std::cerr << "Test failed: split keeps empty fields and points into the string" << std::endl;
+        }
+        my_str_simd_view("").split(',', fields);
+        bool const empty_ok = fields.size() == 1 && fields[0].empty();
+        my_str_simd_view("no delimiters").split(',', fields);
+        if (empty_ok && fields.size() == 1 && fields[0] == "no delimiters") {
+            std::cout << "Test passed: split of text without delimiters gives one field" << std::endl;
+        } else {
+            std::cerr << "Test failed: split of text without delimiters gives one field" << std::endl;
+        }
+
+        std::string long_row;
+        for (int i = 0; i < 200; ++i) {
+            long_row += std::string(i % 37, char('a' + i % 26));
+            long_row += ",;\t"[i % 3];
+        }
+        auto reference_split = [&long_row](const std::string& charset) {
+            std::vector<std::string> result(1);
+            for (char c : long_row) {
+                if (charset.find(c) != std::string::npos) {
+                    result.emplace_back();
+                } else {
+                    result.back() += c;
+                }
+            }
+            return result;
+        };
+        auto to_strings = [](const std::vector<my_str_simd_view>& views) {
+            std::vector<std::string> result;
+            for (my_str_simd_view view : views) {
+                result.emplace_back(view.data(), view.size());
+            }
+            return result;
+        };
+        my_str_simd_view long_view(long_row.data(), long_row.size());
+        long_view.split(',', fields);
+        bool split_ok = to_strings(fields) == reference_split(",");
+        long_view.split_any(",\t", fields);
+        split_ok = split_ok && to_strings(fields) == reference_split(",\t");
+        std::string const wide_set = ";0123456789ABCDEFGHIJ\t";
+        long_view.split_any(my_str_simd_view(wide_set.data(), wide_set.size()), fields);
+        split_ok = split_ok && to_strings(fields) == reference_split(wide_set);
+        my_str_simd long_copy(long_row);
+        long_copy.split_any("", fields);
+        split_ok = split_ok && fields.size() == 1 && fields[0].size() == long_row.size();
+        if (split_ok) {
+            std::cout << "Test passed: split / split_any match a reference split" << std::endl;
+        } else {
+            std::cerr << "Test failed: split / split_any match a reference split" << std::endl;
+        }
+    }
+    // join / concat: одна точна алокація під увесь результат
+    {
+        std::vector<std::string> parts = {"alpha", "", std::string(100, 'b'), "gamma"};
+        my_str_simd joined = my_str_simd::join(parts, ", ");
+        std::string expected_join = "alpha, , " + std::string(100, 'b') + ", gamma";
+        const char* words[] = {"x", "yz"};
+        std::vector<my_str_simd_view> no_parts;
+        if (joined == expected_join.c_str() && joined.capacity() == expected_join.size() + 1
+            && my_str_simd::join(words, "--") == "x--yz" && my_str_simd::join(no_parts, ",").size() == 0
+            && my_str_simd::join(std::vector<my_str_simd>{my_str_simd("one")}, ",") == "one") {
+            std::cout << "Test passed: join" << std::endl;
+        } else {
+            std::cerr << "Test failed: join" << std::endl;
+        }
+        my_str_simd left("left"), right("right");
+        my_str_simd concatenated = my_str_simd::concat({left, "-", my_str_simd_view("mid"), right});
+        my_str_simd sum = left + right;
+        if (concatenated == "left-midright" && concatenated.capacity() == concatenated.size() + 1
+            && sum == "leftright" && sum.capacity() == sum.size() + 1
+            && "<" + left == "<left" && '[' + right == "[right" && left + "!" == "left!") {
+            std::cout << "Test passed: concat and operator+ keep operand order" << std::endl;
+        } else {
+            std::cerr << "Test failed: concat and operator+ keep operand order" << std::endl;
+        }
+    }
+    // operator+ з тимчасовими операндами: результат забирає їхній буфер
+    {
+        my_str_simd head("head of a long template fragment");
+        const char* head_buffer = head.c_str();
+        my_str_simd moved_left = std::move(head) + my_str_simd("+") + "tail" + '!';
+        my_str_simd tail("tail of another long fragment");
+        const char* tail_buffer = tail.c_str();
+        my_str_simd prefix("x");
+        my_str_simd moved_right = "<" + ('[' + (prefix + std::move(tail)));
+        my_str_simd self("ab");
+        my_str_simd doubled = self + std::move(self);
+        if (moved_left == "head of a long template fragment+tail!" && moved_left.c_str() == head_buffer
+            && moved_right == "<[xtail of another long fragment" && moved_right.c_str() == tail_buffer
+            && doubled == "abab") {
+            std::cout << "Test passed: rvalue operator+ reuses the operand buffer" << std::endl;
+        } else {
+            std::cerr << "Test failed: rvalue operator+ reuses the operand buffer" << std::endl;
+        }
+    }
+    // to_upper / to_lower: лише ASCII-літери, межі діапазонів і байти >= 0x80 не змінюються
+    {
+        std::string mixed;
+        for (int i = 0; i < 300; ++i) {
+            mixed += static_cast<char>(1 + (i * 7) % 255);
+        }
+        mixed += "@AZ[`az{ Content-Type \xC3\xA9";
+        std::string upper_expected = mixed, lower_expected = mixed;
+        for (char& c : upper_expected) {
+            if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        }
+        for (char& c : lower_expected) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        my_str_simd text(mixed);
+        my_str_simd upper = text.to_upper_copy();
+        my_str_simd lower = text.to_lower_copy();
+        bool case_ok = std::string(upper.c_str(), upper.size()) == upper_expected
+            && std::string(lower.c_str(), lower.size()) == lower_expected
+            && upper.capacity() == upper.size() + 1 && text.size() == mixed.size();
+        text.to_upper();
+        case_ok = case_ok && text == upper;
+        text.to_lower();
+        case_ok = case_ok && text == lower;
+        if (case_ok) {
+            std::cout << "Test passed: to_upper / to_lower match an ASCII reference" << std::endl;
+        } else {
+            std::cerr << "Test failed: to_upper / to_lower match an ASCII reference" << std::endl;
+        }
+    }
+    // trim / ltrim / rtrim: view, копія і зміна на місці
+    {
+        std::string const body = "value with  inner\tspaces" + std::string(70, 'v');
+        std::string const padded = std::string(40, ' ') + "\t\r\n" + body + " \v\f" + std::string(37, '\n');
+        my_str_simd_view padded_view(padded.data(), padded.size());
+        my_str_simd_view body_view(body.data(), body.size());
+        std::string const left_expected = body + " \v\f" + std::string(37, '\n');
+        std::string const right_expected = std::string(40, ' ') + "\t\r\n" + body;
+        bool trim_ok = padded_view.trim() == body_view
+            && padded_view.ltrim() == my_str_simd_view(left_expected.data(), left_expected.size())
+            && padded_view.rtrim() == my_str_simd_view(right_expected.data(), right_expected.size())
+            && padded_view.trim().data() == padded.data() + 43
+            && my_str_simd_view("   ").trim().empty() && my_str_simd_view("").trim().empty()
+            && my_str_simd_view(" x").rtrim() == " x" && my_str_simd_view("x ").ltrim() == "x ";
+        my_str_simd text(padded);
+        my_str_simd copy = text.trim_copy();
+        trim_ok = trim_ok && copy == body.c_str() && copy.capacity() == body.size() + 1
+            && text.ltrim_copy() == left_expected.c_str() && text.rtrim_copy() == right_expected.c_str();
+        text.trim();
+        trim_ok = trim_ok && text == body.c_str();
+        my_str_simd blank(" \t ");
+        blank.trim();
+        trim_ok = trim_ok && blank.size() == 0 && blank == "";
+        if (trim_ok) {
+            std::cout << "Test passed: trim / ltrim / rtrim" << std::endl;
+        } else {
+            std::cerr << "Test failed: trim / ltrim / rtrim" << std::endl;
+        }
+    }
+    // replace / replace_all
+    {
+        my_str_simd greeting("Hello, World!");
+        greeting.replace(7, 5, "C++ strings");
+        bool replace_ok = greeting == "Hello, C++ strings!";
+        greeting.replace(0, 100, "x");
+        replace_ok = replace_ok && greeting == "x";
+        greeting.replace(1, 0, greeting);
+        replace_ok = replace_ok && greeting == "xx";
+        try {
+            greeting.replace(3, 1, "y");
+            replace_ok = false;
+        } catch (const std::out_of_range&) {
+        }
+        if (replace_ok) {
+            std::cout << "Test passed: replace" << std::endl;
+        } else {
+            std::cerr << "Test failed: replace" << std::endl;
+        }
+
+        std::string page;
+        for (int i = 0; i < 120; ++i) {
+            page += "<li>{{name}}</li>" + std::string(i % 40, ' ');
+        }
+        auto reference_replace = [&page](const std::string& from, const std::string& to) {
+            std::string result;
+            size_t start = 0;
+            for (size_t pos = page.find(from); pos != std::string::npos; pos = page.find(from, pos + from.size())) {
+                result += page.substr(start, pos - start) + to;
+                start = pos + from.size();
+            }
+            return result + page.substr(start);
+        };
+        my_str_simd longer(page), shorter(page), same(page);
+        size_t const grown = longer.replace_all("{{name}}", "a much longer replacement");
+        size_t const shrunk = shorter.replace_all("{{name}}", "?");
+        size_t const missing = same.replace_all("{{absent}}", "x");
+        my_str_simd overlapping("aaaaa");
+        size_t const pairs = overlapping.replace_all("aa", "b");
+        my_str_simd self_to("ab-ab");
+        self_to.replace_all("-", self_to);
+        if (grown == 120 && shrunk == 120 && missing == 0 && pairs == 2 && overlapping == "bba"
+            && longer == reference_replace("{{name}}", "a much longer replacement").c_str()
+            && shorter == reference_replace("{{name}}", "?").c_str() && same == page.c_str()
+            && longer.capacity() == longer.size() + 1 && self_to == "abab-abab"
+            && same.replace_all("", "x") == 0) {
+            std::cout << "Test passed: replace_all" << std::endl;
+        } else {
+            std::cerr << "Test failed: replace_all" << std::endl;
+        }
+    }
+    // translate: кілька замін (blend) і повна таблиця на 256 записів
+    {
+        std::string bytes;
+        for (int i = 0; i < 700; ++i) {
+            bytes += static_cast<char>(1 + (i * 37) % 255);
+        }
+        uint8_t separators[256];
+        uint8_t identifier[256];
+        for (int c = 0; c < 256; ++c) {
+            separators[c] = static_cast<uint8_t>(c);
+            bool const alnum = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            identifier[c] = alnum ? static_cast<uint8_t>(c >= 'A' && c <= 'Z' ? c + 32 : c) : '_';
+        }
+        separators[static_cast<unsigned char>(',')] = '\t';
+        separators[static_cast<unsigned char>(';')] = '\t';
+        separators[0xFF] = '?';
+        auto reference_translate = [&bytes](const uint8_t* table) {
+            std::string result = bytes;
+            for (char& c : result) {
+                c = static_cast<char>(table[static_cast<unsigned char>(c)]);
+            }
+            return result;
+        };
+        my_str_simd small_set(bytes), full_table(bytes);
+        small_set.translate(separators);
+        full_table.translate(identifier);
+        my_str_simd header("Content-Type: text/html");
+        header.translate(identifier);
+        if (std::string(small_set.c_str(), small_set.size()) == reference_translate(separators)
+            && std::string(full_table.c_str(), full_table.size()) == reference_translate(identifier)
+            && header == "content_type__text_html") {
+            std::cout << "Test passed: translate" << std::endl;
+        } else {
+            std::cerr << "Test failed: translate" << std::endl;
+        }
+    }
+    // is_valid_utf8 і конструктор з перевіркою
+    {
+        std::string const ascii(200, 'a');
+        std::string const valid = ascii + "\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80 \xED\x9F\xBF \xF4\x8F\xBF\xBF" + ascii + "\xD0\xAF";
+        const char* invalid_cases[] = {
+            "\x80",                 // продовження без початку
+            "\xC3",                 // обірвана двобайтова
+            "\xC0\xAF",             // надлишкове кодування
+            "\xE0\x80\xAF",         // надлишкова трибайтова
+            "\xED\xA0\x80",         // сурогат
+            "\xF4\x90\x80\x80",     // понад U+10FFFF
+            "\xF8\x88\x80\x80\x80", // п'ятибайтова
+            "\xE2\x82",             // обірвана трибайтова
+            "\xF0\x9F\x98",         // обірвана чотирибайтова
+            "\xC3\xA9\xA9",         // зайве продовження
+        };
+        bool utf8_ok = my_str_simd(valid).is_valid_utf8() && my_str_simd_view("").is_valid_utf8()
+            && my_str_simd_view(ascii.data(), ascii.size()).is_valid_utf8();
+        for (const char* bad : invalid_cases) {
+            for (size_t prefix : {size_t(0), size_t(13), size_t(62), size_t(63), size_t(64), size_t(200)}) {
+                std::string text = ascii.substr(0, prefix) + bad;
+                std::string padded = text + ascii;
+                if (my_str_simd_view(text.data(), text.size()).is_valid_utf8()
+                    || my_str_simd_view(padded.data(), padded.size()).is_valid_utf8()) {
+                    utf8_ok = false;
+                }
+            }
+        }
+        for (size_t shift = 0; shift < 70; ++shift) {
+            std::string text = ascii.substr(0, shift) + valid;
+            if (!my_str_simd_view(text.data(), text.size()).is_valid_utf8()) {
+                utf8_ok = false;
+            }
+        }
+        if (utf8_ok) {
+            std::cout << "Test passed: is_valid_utf8" << std::endl;
+        } else {
+            std::cerr << "Test failed: is_valid_utf8" << std::endl;
+        }
+        my_str_simd checked(my_str_simd_view(valid.data(), valid.size()), my_str_simd::validate_utf8);
+        try {
+            my_str_simd rejected("ok \xC3(", my_str_simd::validate_utf8);
+            std::cerr << "Test failed: validating constructor accepted invalid UTF-8" << std::endl;
+        } catch (const std::invalid_argument&) {
+            if (checked.size() == valid.size()) {
+                std::cout << "Test passed: validating constructor" << std::endl;
+            } else {
+                std::cerr << "Test failed: validating constructor" << std::endl;
+            }
+        }
+    }
+    // utf8_length / utf8_offset / my_str_simd_code_points
+    {
+        std::string const text = std::string(40, 'a') + "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80" + std::string(30, 'b') + "\xD0\xAF";
+        my_str_simd_view view(text.data(), text.size());
+        size_t const length = 40 + 3 + 30 + 1;
+        bool utf8_ok = view.utf8_length() == length && my_str_simd(text).utf8_length() == length
+            && view.utf8_offset(0) == 0 && view.utf8_offset(40) == 40 && view.utf8_offset(41) == 42
+            && view.utf8_offset(42) == 45 && view.utf8_offset(43) == 49 && view.utf8_offset(73) == 79
+            && view.utf8_offset(length) == text.size() && view.substr(0, view.utf8_offset(42)).utf8_length() == 42;
+        try {
+            view.utf8_offset(length + 1);
+            utf8_ok = false;
+        } catch (const std::out_of_range&) {
+        }
+        std::vector<char32_t> code_points;
+        std::vector<size_t> offsets;
+        my_str_simd_code_points const mixed("x\xC3\xA9\xF0\x9F\x98\x80\xFFy");
+        for (auto it = mixed.begin(); it != mixed.end(); ++it) {
+            code_points.push_back(*it);
+            offsets.push_back(it.offset());
+        }
+        size_t counted = 0;
+        for (char32_t c : my_str_simd_code_points(view)) {
+            (void)c;
+            ++counted;
+        }
+        utf8_ok = utf8_ok && counted == length
+            && code_points == std::vector<char32_t>{U'x', U'é', U'\U0001F600', 0xFFFD, U'y'}
+            && offsets == std::vector<size_t>{0, 1, 3, 7, 8};
+        if (utf8_ok) {
+            std::cout << "Test passed: utf8_length / utf8_offset / code points" << std::endl;
+        } else {
+            std::cerr << "Test failed: utf8_length / utf8_offset / code points" << std::endl;
+        }
+    }
+    // to_utf16 / to_utf32 / from_utf16 / from_utf32
+    {
+        std::string const corpora[] = {
+            std::string(100, 'a') + "tail",
+            "caf\xC3\xA9 na\xC3\xAFve r\xC3\xA9sum\xC3\xA9 " + std::string(40, 'x') + "\xC3\xA9",
+            "\xE4\xB8\xAD\xE6\x96\x87\xE5\xAD\x97\xE7\xAC\xA6\xE4\xB8\xB2 ab \xE6\xBC\xA2\xE5\xAD\x97",
+            "\xF0\x9F\x98\x80\xF0\x9F\x8E\x89 " + std::string(20, 'z') + "\xF0\x9F\x91\x8D!",
+        };
+        bool utf16_ok = my_str_simd("").to_utf16().empty() && my_str_simd::from_utf32(U"", 0).size() == 0;
+        for (const std::string& text : corpora) {
+            my_str_simd const str(text);
+            std::u16string const utf16 = str.to_utf16();
+            std::u32string const utf32 = str.to_utf32();
+            utf16_ok = utf16_ok && utf32.size() == str.utf8_length()
+                && my_str_simd::from_utf16(utf16) == str && my_str_simd::from_utf32(utf32) == str
+                && my_str_simd_view(str).to_utf32() == utf32;
+        }
+        utf16_ok = utf16_ok && my_str_simd("\xC3\xA9\xF0\x9F\x98\x80").to_utf16() == u"é\U0001F600"
+            && my_str_simd("\xC3\xA9\xF0\x9F\x98\x80").to_utf32() == U"é\U0001F600"
+            && my_str_simd::from_utf16(u"я中\U0001F600") == my_str_simd("\xD1\x8F\xE4\xB8\xAD\xF0\x9F\x98\x80");
+
+        std::string const broken = std::string(20, 'a') + "\xC3\xA9" + "\xE0\x80\x80" + "b";
+        std::u16string partial;
+        utf16_ok = utf16_ok && my_str_simd(broken).to_utf16(partial) == 22 && partial == std::u16string(20, u'a') + u"é";
+        std::u32string partial32;
+        utf16_ok = utf16_ok && my_str_simd("ok").to_utf32(partial32) == my_str_simd::not_found && partial32 == U"ok";
+        try {
+            my_str_simd(broken).to_utf32();
+            utf16_ok = false;
+        } catch (const std::invalid_argument&) {
+        }
+        try {
+            std::u16string lone = std::u16string(30, u'q');
+            lone[25] = 0xD800;
+            my_str_simd::from_utf16(lone);
+            utf16_ok = false;
+        } catch (const std::invalid_argument&) {
+        }
+        try {
+            char32_t const too_large[] = {U'a', 0x110000};
+            my_str_simd::from_utf32(too_large, 2);
+            utf16_ok = false;
+        } catch (const std::invalid_argument&) {
+        }
+        if (utf16_ok) {
+            std::cout << "Test passed: to_utf16 / to_utf32 / from_utf16 / from_utf32" << std::endl;
+        } else {
+            std::cerr << "Test failed: to_utf16 / to_utf32 / from_utf16 / from_utf32" << std::endl;
+        }
+    }
+    // base64_encode / base64_decode
+    {
+        bool base64_ok = my_str_simd("").base64_encode() == my_str_simd("") && my_str_simd("f").base64_encode() == my_str_simd("Zg==")
+            && my_str_simd("fo").base64_encode() == my_str_simd("Zm8=") && my_str_simd("foo").base64_encode() == my_str_simd("Zm9v")
+            && my_str_simd("foobar").base64_encode() == my_str_simd("Zm9vYmFy")
+            && my_str_simd("Zm9vYg==").base64_decode() == my_str_simd("foob") && my_str_simd("Zm9vYmE=").base64_decode() == my_str_simd("fooba")
+            && my_str_simd("").base64_decode().size() == 0;
+        std::string binary;
+        for (size_t k = 0; k < 300; ++k) {
+            binary += static_cast<char>((k * 37 + 11) & 0xFF);
+        }
+        for (size_t length : {size_t(47), size_t(48), size_t(100), size_t(299), size_t(300)}) {
+            my_str_simd const raw(binary.substr(0, length));
+            my_str_simd const encoded = raw.base64_encode();
+            base64_ok = base64_ok && encoded.size() == (length + 2) / 3 * 4 && encoded.base64_decode() == raw;
+        }
+        my_str_simd const wrapped(std::string(76, 'A') + "\r\n" + std::string(40, 'B') + "\nQQ");
+        base64_ok = base64_ok && wrapped.base64_decode(my_str_simd::base64_mode::lenient).size() == (76 + 40) / 4 * 3 + 1
+            && my_str_simd("Zm9vYg").base64_decode(my_str_simd::base64_mode::lenient) == my_str_simd("foob")
+            && my_str_simd("Zh==").base64_decode(my_str_simd::base64_mode::lenient) == my_str_simd("f");
+        for (const char* bad : {"Zm9", "Zm9v!mFy", "Zh==", "Zg=a", "Z===", "Zm9v Zm9v", "Zm9vY"}) {
+            try {
+                my_str_simd(bad).base64_decode();
+                base64_ok = false;
+            } catch (const std::invalid_argument&) {
+            }
+        }
+        try {
+            my_str_simd(std::string(70, 'A') + "*" + std::string(9, 'A')).base64_decode(my_str_simd::base64_mode::lenient);
+            base64_ok = false;
+        } catch (const std::invalid_argument&) {
+        }
+        if (base64_ok) {
+            std::cout << "Test passed: base64_encode / base64_decode" << std::endl;
+        } else {
+            std::cerr << "Test failed: base64_encode / base64_decode" << std::endl;
+        }
+    }
+    // to_hex / from_hex
+    {
+        std::string binary;
+        for (size_t k = 0; k < 256; ++k) {
+            binary += static_cast<char>(k);
+        }
+        my_str_simd const raw(binary);
+        my_str_simd const hex = raw.to_hex();
+        bool hex_ok = hex.size() == 512 && hex.substr(0, 8) == my_str_simd("00010203") && hex.substr(504, 8) == my_str_simd("fcfdfeff")
+            && my_str_simd::from_hex(hex) == raw && my_str_simd("").to_hex().size() == 0 && my_str_simd::from_hex("").size() == 0
+            && my_str_simd::from_hex("DEADbeef") == my_str_simd("\xDE\xAD\xBE\xEF") && my_str_simd("\x01\xAB").to_hex() == my_str_simd("01ab");
+        std::string upper = hex.c_str();
+        for (char& c : upper) {
+            if (c >= 'a' && c <= 'f') {
+                c = static_cast<char>(c - 'a' + 'A');
+            }
+        }
+        hex_ok = hex_ok && my_str_simd::from_hex(upper.c_str()) == raw;
+        for (size_t bad_pos : {size_t(0), size_t(17), size_t(63), size_t(64), size_t(101)}) {
+            std::string broken(128, 'a');
+            broken[bad_pos] = 'g';
+            try {
+                my_str_simd::from_hex(broken.c_str());
+                hex_ok = false;
+            } catch (const std::invalid_argument& error) {
+                hex_ok = hex_ok && std::string(error.what()).find(std::to_string(bad_pos)) != std::string::npos;
+            }
+        }
+        try {
+            my_str_simd::from_hex("abc");
+            hex_ok = false;
+        } catch (const std::invalid_argument&) {
+        }
+        if (hex_ok) {
+            std::cout << "Test passed: to_hex / from_hex" << std::endl;
+        } else {
+            std::cerr << "Test failed: to_hex / from_hex" << std::endl;
+        }
+    }
+    // escape_json / escape_html / escape_csv
+    {
+        std::string const clean(100, 'x');
+        my_str_simd const plain(clean);
+        my_str_simd const json_text(clean + "\"q\\\n\t\x01" + clean + "\x1f");
+        my_str_simd const html_text(std::string(40, 'h') + "<a href=\"x\">Tom & 'Jerry'</a>");
+        bool escape_ok = plain.escape_json() == plain && plain.escape_html() == plain && plain.escape_csv() == plain
+            && my_str_simd("").escape_json().size() == 0 && my_str_simd("").escape_csv().size() == 0
+            && json_text.escape_json() == my_str_simd((clean + "\\\"q\\\\\\n\\t\\u0001" + clean + "\\u001f").c_str())
+            && html_text.escape_html() == my_str_simd((std::string(40, 'h') + "&lt;a href=&quot;x&quot;&gt;Tom &amp; &#39;Jerry&#39;&lt;/a&gt;").c_str())
+            && my_str_simd("a,b").escape_csv() == my_str_simd("\"a,b\"") && my_str_simd("line\nbreak").escape_csv() == my_str_simd("\"line\nbreak\"")
+            && my_str_simd((clean + "say \"hi\"" + clean).c_str()).escape_csv() == my_str_simd(("\"" + clean + "say \"\"hi\"\"" + clean + "\"").c_str())
+            && my_str_simd("\xC3\xA9t\xC3\xA9").escape_json() == my_str_simd("\xC3\xA9t\xC3\xA9");
+        if (escape_ok) {
+            std::cout << "Test passed: escape_json / escape_html / escape_csv" << std::endl;
+        } else {
+            std::cerr << "Test failed: escape_json / escape_html / escape_csv" << std::endl;
+        }
+    }
+    // url_decode / parse_url
+    {
+        std::string const long_path(60, 'p');
+        my_str_simd const encoded(("/" + long_path + "/a%20b+c%2Fd%c3%A9").c_str());
+        bool url_ok = encoded.url_decode() == my_str_simd(("/" + long_path + "/a b c/d\xC3\xA9").c_str())
+            && encoded.url_decode(false) == my_str_simd(("/" + long_path + "/a b+c/d\xC3\xA9").c_str())
+            && my_str_simd("").url_decode().size() == 0 && my_str_simd("plain").url_decode() == my_str_simd("plain");
+        for (const char* bad : {"%", "abc%2", "%zz", "x%4g"}) {
+            try {
+                my_str_simd(bad).url_decode();
+                url_ok = false;
+            } catch (const std::invalid_argument&) {
+            }
+        }
+        my_str_simd const full(("https://user:pw@example.com:8443/" + long_path + "/index.html?q=1&r=2#top").c_str());
+        my_str_simd_url const parts = full.parse_url();
+        url_ok = url_ok && parts.scheme == my_str_simd_view("https") && parts.userinfo == my_str_simd_view("user:pw")
+            && parts.host == my_str_simd_view("example.com") && parts.port == my_str_simd_view("8443")
+            && parts.path == my_str_simd_view(("/" + long_path + "/index.html").c_str())
+            && parts.query == my_str_simd_view("q=1&r=2") && parts.fragment == my_str_simd_view("top")
+            && parts.host.data() == full.c_str() + 16;
+        my_str_simd_url const ipv6 = my_str_simd_view("http://[::1]/x").parse_url();
+        my_str_simd_url const relative = my_str_simd_view("/search?q=a:b").parse_url();
+        my_str_simd_url const mail = my_str_simd_view("mailto:someone@example.com").parse_url();
+        url_ok = url_ok && ipv6.host == my_str_simd_view("[::1]") && ipv6.port.size() == 0 && ipv6.path == my_str_simd_view("/x")
+            && relative.scheme.size() == 0 && relative.path == my_str_simd_view("/search") && relative.query == my_str_simd_view("q=a:b")
+            && mail.scheme == my_str_simd_view("mailto") && mail.host.size() == 0 && mail.path == my_str_simd_view("someone@example.com");
+        if (url_ok) {
+            std::cout << "Test passed: url_decode / parse_url" << std::endl;
+        } else {
+            std::cerr << "Test failed: url_decode / parse_url" << std::endl;
+        }
+    }
+    // to_int64 / to_uint64 / append_int / from_int
+    {
+        bool int_ok = my_str_simd("0").to_int64() == 0 && my_str_simd("-0").to_int64() == 0 && my_str_simd("+42").to_int64() == 42
+            && my_str_simd("1234567890123456").to_int64() == 1234567890123456LL
+            && my_str_simd("-9223372036854775808").to_int64() == INT64_MIN && my_str_simd("9223372036854775807").to_int64() == INT64_MAX
+            && my_str_simd("18446744073709551615").to_uint64() == UINT64_MAX
+            && my_str_simd("00000000000000000000000000000000017").to_uint64() == 17
+            && my_str_simd_view("x=12345;", 8).substr(2, 5).to_int64() == 12345;
+        for (const char* bad : {"", "-", "+", "12a", " 1", "1 ", "--1", "0x10"}) {
+            try {
+                my_str_simd(bad).to_int64();
+                int_ok = false;
+            } catch (const std::invalid_argument&) {
+            }
+        }
+        for (const char* large : {"9223372036854775808", "-9223372036854775809", "100000000000000000000"}) {
+            try {
+                my_str_simd(large).to_int64();
+                int_ok = false;
+            } catch (const std::out_of_range&) {
+            }
+        }
+        try {
+            my_str_simd("18446744073709551616").to_uint64();
+            int_ok = false;
+        } catch (const std::out_of_range&) {
+        }
+        try {
+            my_str_simd("-1").to_uint64();
+            int_ok = false;
+        } catch (const std::invalid_argument&) {
+        }
+        my_str_simd row("id=");
+        row.append_int(-1234567);
+        row.append(',');
+        row.append_uint(UINT64_MAX);
+        int_ok = int_ok && row == my_str_simd("id=-1234567,18446744073709551615")
+            && my_str_simd::from_int(INT64_MIN) == my_str_simd("-9223372036854775808") && my_str_simd::from_int(0) == my_str_simd("0")
+            && my_str_simd::from_int(7) == my_str_simd("7") && my_str_simd::from_uint(10) == my_str_simd("10")
+            && my_str_simd::from_int(-987654321098765LL).to_int64() == -987654321098765LL;
+        if (int_ok) {
+            std::cout << "Test passed: to_int64 / to_uint64 / append_int / from_int" << std::endl;
+        } else {
+            std::cerr << "Test failed: to_int64 / to_uint64 / append_int / from_int" << std::endl;
+        }
+    }
+    // to_double / append_double
+    {
+        bool double_ok = my_str_simd("0").to_double() == 0.0 && my_str_simd("-1.5").to_double() == -1.5 && my_str_simd("+2.25e2").to_double() == 225.0
+            && my_str_simd("0.1").to_double() == 0.1 && my_str_simd(".5").to_double() == 0.5 && my_str_simd("1e-22").to_double() == 1e-22
+            && my_str_simd("123456789012345678901234567890").to_double() == 123456789012345678901234567890.0
+            && my_str_simd("2.2250738585072014e-308").to_double() == 2.2250738585072014e-308
+            && my_str_simd("9007199254740993").to_double() == 9007199254740992.0
+            && my_str_simd("1.7976931348623157e308").to_double() == 1.7976931348623157e308
+            && my_str_simd("-inf").to_double() == -std::numeric_limits<double>::infinity();
+        for (const char* bad : {"", "-", "+-1", "1e", "1.2.3", "abc", " 1", "1 ", "0x10"}) {
+            try {
+                my_str_simd(bad).to_double();
+                double_ok = false;
+            } catch (const std::invalid_argument&) {
+            }
+        }
+        try {
+            my_str_simd("1e400").to_double();
+            double_ok = false;
+        } catch (const std::out_of_range&) {
+        }
+        my_str_simd row("x=");
+        row.append_double(0.1);
+        row.append(',');
+        row.append_double(-2.5e-300);
+        double_ok = double_ok && row == my_str_simd("x=0.1,-2.5e-300") && my_str_simd::from_double(100) == my_str_simd("100")
+            && my_str_simd::from_double(1.0 / 3).to_double() == 1.0 / 3;
+        if (double_ok) {
+            std::cout << "Test passed: to_double / append_double" << std::endl;
+        } else {
+            std::cerr << "Test failed: to_double / append_double" << std::endl;
+        }
+    }
+    // json_index
+    {
+        std::vector<size_t> positions;
+        my_str_simd doc("{\"a\\\"{\": [1, \"x,y\\\\\"], \"b\": {}}");
+        doc.json_index(positions);
+        std::vector<size_t> expected = {0, 1, 6, 7, 9, 11, 13, 19, 20, 21, 23, 25, 26, 28, 29, 30};
+        bool index_ok = positions == expected;
+        std::string big = "[";
+        for (int i = 0; i < 40; ++i) {
+            big += "\"k\\\\\\\"{\",";
+        }
+        big += "0]";
+        my_str_simd(big.c_str()).json_index(positions);
+        index_ok = index_ok && positions.size() == 40 * 3 + 2 && positions.front() == 0 && positions[1] == 1
+            && positions[2] == 8 && positions[3] == 9 && positions.back() == big.size() - 1;
+        try {
+            my_str_simd("{\"open\\\": 1}").json_index(positions);
+            index_ok = false;
+        } catch (const std::invalid_argument&) {
+        }
+        if (index_ok) {
+            std::cout << "Test passed: json_index" << std::endl;
+        } else {
+            std::cerr << "Test failed: json_index" << std::endl;
+        }
+    }
+    // my_str_simd_csv
+    {
+        my_str_simd_view table("name,note,n\r\n\"Smith, J\",\"say \"\"hi\"\"\nbye\",3\n,,\nlast");
+        std::vector<std::vector<std::string>> rows;
+        for (const auto& row : my_str_simd_csv(table)) {
+            std::vector<std::string> fields;
+            for (my_str_simd_view field : row) {
+                fields.emplace_back(field.data(), field.size());
+            }
+            rows.push_back(fields);
+        }
+        std::vector<std::vector<std::string>> expected = {
+            {"name", "note", "n"}, {"Smith, J", "say \"\"hi\"\"\nbye", "3"}, {"", "", ""}, {"last"}};
+        bool csv_ok = rows == expected;
+        std::string wide;
+        for (int i = 0; i < 50; ++i) {
+            wide += "a\t\"b\tc\nd\"\t" + std::to_string(i) + "\n";
+        }
+        size_t count = 0;
+        for (const auto& row : my_str_simd_csv(my_str_simd_view(wide.data(), wide.size()), '\t')) {
+            csv_ok = csv_ok && row.size() == 3 && row[1] == my_str_simd_view("b\tc\nd", 5)
+                && row[2] == my_str_simd_view(std::to_string(count).c_str());
+            ++count;
+        }
+        csv_ok = csv_ok && count == 50 && my_str_simd_csv(my_str_simd_view("", 0)).begin() == my_str_simd_csv(my_str_simd_view("", 0)).end();
+        if (csv_ok) {
+            std::cout << "Test passed: my_str_simd_csv" << std::endl;
+        } else {
+            std::cerr << "Test failed: my_str_simd_csv" << std::endl;
+        }
+    }
+    // collapse_whitespace
+    {
+        my_str_simd words("  a \t\n b\r\n\ncd \v\f ");
+        my_str_simd copy = words.collapse_whitespace_copy();
+        words.collapse_whitespace();
+        bool collapse_ok = words == "a b cd" && copy == "a b cd" && words.size() == 6;
+        std::string raw;
+        std::string expected;
+        for (int i = 0; i < 30; ++i) {
+            raw += std::string(i % 7 + 1, ' ') + "word" + std::to_string(i) + (i % 3 == 0 ? "\t\t\n" : "");
+            expected += (i == 0 ? "" : " ") + std::string("word") + std::to_string(i);
+        }
+        raw += "   ";
+        my_str_simd text(raw.c_str());
+        text.collapse_whitespace();
+        collapse_ok = collapse_ok && text == expected.c_str();
+        my_str_simd blank(" \t\n\r   ");
+        blank.collapse_whitespace();
+        collapse_ok = collapse_ok && blank.size() == 0 && my_str_simd("").collapse_whitespace_copy().size() == 0;
+        if (collapse_ok) {
+            std::cout << "Test passed: collapse_whitespace" << std::endl;
+        } else {
+            std::cerr << "Test failed: collapse_whitespace" << std::endl;
+        }
+    }
+    // remove / remove_any
+    {
+        my_str_simd dashes("a-b--c-");
+        dashes.remove('-');
+        bool remove_ok = dashes == "abc";
+        std::string raw;
+        std::string expected;
+        for (int i = 0; i < 200; ++i) {
+            char const c = static_cast<char>(i % 128);
+            if (c == '\0') {
+                continue;
+            }
+            raw += c;
+            if (static_cast<unsigned char>(c) >= 0x20 && c != 0x7F) {
+                expected += c;
+            }
+        }
+        raw += "\xC3\xA9\x01";
+        expected += "\xC3\xA9";
+        std::string controls;
+        for (char c = 1; c < 0x20; ++c) {
+            controls += c;
+        }
+        controls += '\x7F';
+        my_str_simd input(raw.c_str());
+        input.remove_any(my_str_simd_view(controls.c_str()));
+        remove_ok = remove_ok && input == expected.c_str();
+        my_str_simd accents("caf\xC3\xA9 na\xC3\xAFve");
+        accents.remove_any(my_str_simd_view("\xC3 "));
+        remove_ok = remove_ok && accents == "caf\xA9na\xAFve";
+        my_str_simd same("keep");
+        same.remove_any(my_str_simd_view(""));
+        same.remove('x');
+        remove_ok = remove_ok && same == "keep";
+        if (remove_ok) {
+            std::cout << "Test passed: remove / remove_any" << std::endl;
+        } else {
+            std::cerr << "Test failed: remove / remove_any" << std::endl;
+        }
+    }
     return 0;
 }
\ No newline at end of file
@@ -698,6 +698,57 @@ void test_insert_speed() {
 
 
 
+//! пропускна здатність перекодування (МБ/с байтів UTF-8) на різних текстах:
+//! ASCII, латиниця з діакритикою, CJK (3 байти на код) та емодзі (4 байти)
+void test_transcoding_speed() {
+    struct corpus {
+        const char* name;
+        const char* unit;
+    };
+    const corpus corpora[] = {
+        {"ASCII", "The quick brown fox jumps over the lazy dog. "},
+        {"Latin", "Caf\xC3\xA9 cr\xC3\xA8me br\xC3\xBBl\xC3\xA9" "e, na\xC3\xAFve r\xC3\xA9sum\xC3\xA9. "},
+        {"CJK", "\xE4\xB8\xAD\xE6\x96\x87\xE5\xAD\x97\xE7\xAC\xA6\xE4\xB8\xB2\xE6\xBC\xA2\xE5\xAD\x97\xE3\x80\x82"},
+        {"Emoji", "\xF0\x9F\x98\x80\xF0\x9F\x8E\x89\xF0\x9F\x91\x8D \xF0\x9F\x9A\x80\xF0\x9F\x94\xA5 "},
+    };
+    const size_t target_size = 1 << 20;
+    const int runs = 20;
+
+    std::cout << "| Corpus | to_utf16 (MB/s) | to_utf32 (MB/s) | from_utf16 (MB/s) | from_utf32 (MB/s) |\n";
+    std::cout << "|--------|-----------------|-----------------|-------------------|-------------------|\n";
+
+    for (const corpus& c : corpora) {
+        std::string source;
+        while (source.size() < target_size) {
+            source += c.unit;
+        }
+        my_str_simd str(source);
+        std::u16string utf16 = str.to_utf16();
+        std::u32string utf32 = str.to_utf32();
+        volatile size_t checksum = 0;
+
+        auto mb_per_s = [&](auto&& body) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < runs; ++i) {
+                checksum += body();
+            }
+            auto end = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+            return static_cast<double>(source.size()) * runs / seconds / 1e6;
+        };
+
+        double to16 = mb_per_s([&] { return str.to_utf16().size(); });
+        double to32 = mb_per_s([&] { return str.to_utf32().size(); });
+        double from16 = mb_per_s([&] { return my_str_simd::from_utf16(utf16).size(); });
+        double from32 = mb_per_s([&] { return my_str_simd::from_utf32(utf32).size(); });
+        std::cout << "| " << c.name
+                  << " | " << static_cast<long>(to16)
+                  << " | " << static_cast<long>(to32)
+                  << " | " << static_cast<long>(from16)
+                  << " | " << static_cast<long>(from32) << " |\n";
+    }
+}
+
 int main() {
     test_performance();
     test_copy_speed();
@@ -780,5 +831,6 @@ int main() {
     test_find_substring_speed();
     test_find_substring_speed_2();
     test_reserve_speed_table();
+    test_transcoding_speed();
     return 0;
 }
\ No newline at end of file